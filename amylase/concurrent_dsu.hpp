@@ -0,0 +1,87 @@
+#ifndef AMYLASE_CONCURRENT_DSU_HPP
+#define AMYLASE_CONCURRENT_DSU_HPP 1
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace amylase {
+
+// Disjoint set union whose merge, same and leader can be called from many threads at once, without locks.
+// Implement (linking by index) + (path halving)
+// The root with the larger index is linked below the other one by CAS, so the leader of a set is
+// always its smallest element, whatever the order of the merges is.
+// Reference:
+// Richard J. Anderson and Heather Woll,
+// Wait-free Parallel Algorithms for the Union-Find Problem
+struct concurrent_dsu {
+  public:
+    concurrent_dsu() : _n(0) {}
+    concurrent_dsu(int n) : _n(n), parent(new std::atomic<int>[n]) {
+        for (int i = 0; i < n; i++) parent[i].store(i, std::memory_order_relaxed);
+    }
+
+    int merge(int a, int b) {
+        assert(0 <= a && a < _n);
+        assert(0 <= b && b < _n);
+        while (true) {
+            int x = leader(a), y = leader(b);
+            if (x == y) return x;
+            if (x > y) std::swap(x, y);
+            // fails if y has been linked by another thread in the meantime
+            int expected = y;
+            if (parent[y].compare_exchange_strong(expected, x, std::memory_order_acq_rel)) return x;
+            a = x, b = y;
+        }
+    }
+
+    bool same(int a, int b) {
+        assert(0 <= a && a < _n);
+        assert(0 <= b && b < _n);
+        while (true) {
+            int x = leader(a), y = leader(b);
+            if (x == y) return true;
+            // the answer is valid only if x was still a root after y has been found
+            if (parent[x].load(std::memory_order_acquire) == x) return false;
+            a = x, b = y;
+        }
+    }
+
+    int leader(int a) {
+        assert(0 <= a && a < _n);
+        while (true) {
+            int p = parent[a].load(std::memory_order_acquire);
+            if (p == a) return a;
+            int q = parent[p].load(std::memory_order_acquire);
+            // a failure only means that another thread has shortened the path already
+            if (p != q) parent[a].compare_exchange_weak(p, q, std::memory_order_acq_rel);
+            a = q;
+        }
+    }
+
+    // Must not run concurrently with merge.
+    std::vector<std::vector<int>> groups() {
+        std::vector<std::vector<int>> result;
+        std::vector<int> group_id(_n);
+        for (int i = 0; i < _n; i++) {
+            int x = leader(i);
+            // the leader is the smallest element, so it is visited first
+            if (x == i) {
+                group_id[i] = int(result.size());
+                result.emplace_back();
+            }
+            result[group_id[x]].push_back(i);
+        }
+        return result;
+    }
+
+  private:
+    int _n;
+    std::unique_ptr<std::atomic<int>[]> parent;
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_CONCURRENT_DSU_HPP
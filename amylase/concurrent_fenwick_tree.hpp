@@ -0,0 +1,81 @@
+#ifndef AMYLASE_CONCURRENT_FENWICK_TREE_HPP
+#define AMYLASE_CONCURRENT_FENWICK_TREE_HPP 1
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <atcoder/internal_type_traits>
+
+namespace amylase {
+
+// Fenwick tree whose add and sum can be called from many threads at once, without locks.
+// add is a relaxed atomic fetch_add on each visited node. sum includes every add which
+// happened-before it, and any subset of the adds running concurrently with it
+// (it is not linearizable, but fine for monitoring).
+//
+// With stripes > 1, the tree is replicated and each thread adds to its own replica
+// (assigned in round-robin order), so the threads do not fight over the cache lines of the upper nodes.
+// sum merges the replicas, i.e. it is `stripes` times slower.
+template <class T> struct concurrent_fenwick_tree {
+    using U = atcoder::internal::to_unsigned_t<T>;
+    static_assert(std::is_integral<U>::value, "T must be an integral type");
+
+  public:
+    concurrent_fenwick_tree() : concurrent_fenwick_tree(0) {}
+    concurrent_fenwick_tree(int n, int stripes = 1) : _n(n) {
+        assert(stripes >= 1);
+        for (int s = 0; s < stripes; s++) {
+            // one allocation per stripe, so that different stripes never share a cache line
+            data.emplace_back(new std::atomic<U>[n]);
+            for (int i = 0; i < n; i++) data.back()[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void add(int p, T x) { add(p, x, this_thread_stripe()); }
+
+    // @param stripe which replica to add to, in [0, stripes)
+    void add(int p, T x, int stripe) {
+        assert(0 <= p && p < _n);
+        assert(0 <= stripe && stripe < int(data.size()));
+        std::atomic<U>* d = data[stripe].get();
+        p++;
+        while (p <= _n) {
+            d[p - 1].fetch_add(U(x), std::memory_order_relaxed);
+            p += p & -p;
+        }
+    }
+
+    T sum(int l, int r) const {
+        assert(0 <= l && l <= r && r <= _n);
+        return T(sum(r) - sum(l));
+    }
+
+    int stripes() const { return int(data.size()); }
+
+  private:
+    int _n;
+    std::vector<std::unique_ptr<std::atomic<U>[]>> data;
+
+    // The threads are numbered in the order of their first add, and take the stripes in
+    // round-robin order. (std::hash of std::thread::id need not spread the ids over the stripes.)
+    int this_thread_stripe() const {
+        if (data.size() == 1) return 0;
+        static std::atomic<unsigned int> next(0);
+        thread_local unsigned int number = next.fetch_add(1, std::memory_order_relaxed);
+        return int(number % data.size());
+    }
+
+    U sum(int r) const {
+        U s = 0;
+        for (auto& d : data) {
+            for (int p = r; p > 0; p -= p & -p) s += d[p - 1].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_CONCURRENT_FENWICK_TREE_HPP
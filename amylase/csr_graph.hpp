@@ -0,0 +1,230 @@
+#ifndef AMYLASE_CSR_GRAPH_HPP
+#define AMYLASE_CSR_GRAPH_HPP 1
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <atcoder/internal_scc>
+#include <amylase/internal_mapped_file>
+
+namespace amylase {
+
+// payload of the edges of csr_graph<>, which takes no space
+struct csr_no_payload {};
+
+// File format of csr_graph (version 1, native endianness):
+//   csr_header, then the arrays `start` (n + 1 ints), `to` (m ints) and
+//   (unless the payload is empty) `payload` (m elements) at their offsets,
+//   which are multiples of 64.
+struct csr_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t payload_size;
+    std::int64_t n, m;
+    std::uint64_t start_offset, to_offset, payload_offset;
+
+    static constexpr std::uint32_t current_version = 1;
+
+    static csr_header make(std::size_t _payload_size, int _n, int _m) {
+        csr_header h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "AMYLCSR", 8);
+        h.version = current_version;
+        h.payload_size = std::uint32_t(_payload_size);
+        h.n = _n;
+        h.m = _m;
+        h.start_offset = internal::align64(sizeof(csr_header));
+        h.to_offset = internal::align64(h.start_offset + sizeof(int) * (std::size_t(_n) + 1));
+        h.payload_offset = _payload_size ? internal::align64(h.to_offset + sizeof(int) * std::size_t(_m)) : 0;
+        return h;
+    }
+
+    // @return whether the header matches the payload size and fits in a file of `file_size` bytes
+    bool valid(std::size_t _payload_size, std::size_t file_size) const {
+        if (std::memcmp(magic, "AMYLCSR", 8) != 0) return false;
+        if (version != current_version || payload_size != _payload_size) return false;
+        if (n < 0 || n >= (1LL << 31) - 1 || m < 0 || m >= (1LL << 31)) return false;
+        std::uint64_t un = std::uint64_t(n), um = std::uint64_t(m);
+        if (!internal::fits_in_file(start_offset, sizeof(int) * (un + 1), file_size)) return false;
+        if (!internal::fits_in_file(to_offset, sizeof(int) * um, file_size)) return false;
+        if (payload_size && !internal::fits_in_file(payload_offset, payload_size * um, file_size)) return false;
+        return true;
+    }
+};
+
+// Directed graph in compressed sparse row form, with a payload of type E on each edge.
+// The edges from v are begin(v), ..., end(v) - 1, in the order they were added.
+// It is either built by csr_graph_builder, or opened from a file by mmap
+// (copy-on-write pages: the payloads can be updated, and the updates are never written back).
+// atcoder::mf_graph and atcoder::mcf_graph can be constructed from it directly.
+template <class E = csr_no_payload> struct csr_graph {
+    static_assert(std::is_trivially_copyable<E>::value, "E must be trivially copyable");
+    static constexpr std::size_t payload_size = std::is_empty<E>::value ? 0 : sizeof(E);
+
+  public:
+    csr_graph() : _n(0), _start(1, 0) {}
+
+    // edges[i] = (from, to), payloads[i]: the payload of the i-th edge (or empty when E is empty)
+    csr_graph(int n, const std::vector<std::pair<int, int>>& edges, const std::vector<E>& payloads = {}) : _n(n) {
+        assert(0 <= n);
+        assert(payload_size == 0 || payloads.size() == edges.size());
+        int m = int(edges.size());
+        _start = internal::mapped_array<int>(n + 1, 0);
+        _to = internal::mapped_array<int>(m, 0);
+        if (payload_size) _payload = internal::mapped_array<E>(m, E());
+        for (auto e : edges) {
+            assert(0 <= e.first && e.first < n);
+            assert(0 <= e.second && e.second < n);
+            _start[e.first + 1]++;
+        }
+        for (int i = 0; i < n; i++) _start[i + 1] += _start[i];
+        std::vector<int> counter(_start.data(), _start.data() + n);
+        for (int i = 0; i < m; i++) {
+            int j = counter[edges[i].first]++;
+            _to[j] = edges[i].second;
+            if (payload_size) _payload[j] = payloads[i];
+        }
+    }
+
+    int num_vertices() const { return _n; }
+    int num_edges() const { return _start[_n]; }
+    int begin(int v) const {
+        assert(0 <= v && v < _n);
+        return _start[v];
+    }
+    int end(int v) const {
+        assert(0 <= v && v < _n);
+        return _start[v + 1];
+    }
+    int to(int i) const {
+        assert(0 <= i && i < num_edges());
+        return _to[i];
+    }
+    E& payload(int i) {
+        static_assert(payload_size != 0, "the payload is empty");
+        assert(0 <= i && i < num_edges());
+        return _payload[i];
+    }
+    const E& payload(int i) const {
+        static_assert(payload_size != 0, "the payload is empty");
+        assert(0 <= i && i < num_edges());
+        return _payload[i];
+    }
+
+    // the raw arrays, for the algorithms which take a graph in CSR form
+    const internal::mapped_array<int>& start() const { return _start; }
+    const internal::mapped_array<int>& elist() const { return _to; }
+
+    // @return false if the file could not be written
+    bool save(const std::string& path) const {
+        csr_header h = csr_header::make(payload_size, _n, num_edges());
+        std::FILE* fp = std::fopen(path.c_str(), "wb");
+        if (!fp) return false;
+        std::size_t pos = 0;
+        bool ok = internal::write_at(fp, pos, 0, &h, sizeof(h)) &&
+                  internal::write_at(fp, pos, h.start_offset, _start.data(), sizeof(int) * _start.size()) &&
+                  internal::write_at(fp, pos, h.to_offset, _to.data(), sizeof(int) * _to.size());
+        if (ok && payload_size) {
+            ok = internal::write_at(fp, pos, h.payload_offset, _payload.data(), payload_size * _payload.size());
+        }
+        return (std::fclose(fp) == 0) && ok;
+    }
+
+    // Replaces this graph with the one saved in `path`, without copying the arrays.
+    // The arrays are checked in O(n + m) time: start[0] = 0, start is non-decreasing, start[n] = m,
+    // and every head is in [0, n).
+    // @return false (and this graph is unchanged) if the file is missing, broken, or was saved with another payload
+    bool open_mapped(const std::string& path) {
+        auto file = internal::mapped_file::open(path);
+        if (!file || file->size() < sizeof(csr_header)) return false;
+        csr_header h;
+        std::memcpy(&h, file->data(), sizeof(h));
+        if (!h.valid(payload_size, file->size())) return false;
+        int n = int(h.n), m = int(h.m);
+        internal::mapped_array<int> start(file, h.start_offset, n + 1), to(file, h.to_offset, m);
+        if (start[0] != 0 || start[n] != m) return false;
+        for (int v = 0; v < n; v++) {
+            if (start[v] > start[v + 1]) return false;
+        }
+        for (int i = 0; i < m; i++) {
+            if (to[i] < 0 || n <= to[i]) return false;
+        }
+        _n = n;
+        _start = std::move(start);
+        _to = std::move(to);
+        if (payload_size) {
+            _payload = internal::mapped_array<E>(file, h.payload_offset, m);
+        } else {
+            _payload = internal::mapped_array<E>();
+        }
+        return true;
+    }
+
+  private:
+    int _n;
+    internal::mapped_array<int> _start, _to;
+    internal::mapped_array<E> _payload;
+};
+
+// Collects the edges of a csr_graph, then sorts them by the tail in O(n + m).
+template <class E = csr_no_payload> struct csr_graph_builder {
+  public:
+    csr_graph_builder() : csr_graph_builder(0) {}
+    explicit csr_graph_builder(int n) : _n(n) {}
+
+    void reserve(int m) {
+        edges.reserve(m);
+        if (csr_graph<E>::payload_size) payloads.reserve(m);
+    }
+
+    // @return the index of the edge in the order of addition
+    int add_edge(int from, int to, const E& payload = E()) {
+        assert(0 <= from && from < _n);
+        assert(0 <= to && to < _n);
+        int m = int(edges.size());
+        edges.push_back({from, to});
+        if (csr_graph<E>::payload_size) payloads.push_back(payload);
+        return m;
+    }
+
+    // The builder is empty afterwards.
+    csr_graph<E> build() {
+        csr_graph<E> g(_n, edges, payloads);
+        edges.clear();
+        edges.shrink_to_fit();
+        payloads.clear();
+        payloads.shrink_to_fit();
+        return g;
+    }
+
+  private:
+    int _n;
+    std::vector<std::pair<int, int>> edges;
+    std::vector<E> payloads;
+};
+
+// @return pair of (# of scc, scc id), as atcoder::scc_graph, without copying the edges
+template <class E> std::pair<int, std::vector<int>> scc_ids(const csr_graph<E>& g) {
+    auto& elist = g.elist();
+    return atcoder::internal::scc_ids_csr(g.num_vertices(), g.start(), [&](int i) { return elist[i]; });
+}
+
+// @return the strongly connected components in topological order, as atcoder::scc_graph::scc
+template <class E> std::vector<std::vector<int>> scc(const csr_graph<E>& g) {
+    auto ids = scc_ids(g);
+    std::vector<int> counts(ids.first);
+    for (auto x : ids.second) counts[x]++;
+    std::vector<std::vector<int>> groups(ids.first);
+    for (int i = 0; i < ids.first; i++) groups[i].reserve(counts[i]);
+    for (int i = 0; i < g.num_vertices(); i++) groups[ids.second[i]].push_back(i);
+    return groups;
+}
+
+}  // namespace amylase
+
+#endif  // AMYLASE_CSR_GRAPH_HPP
@@ -0,0 +1,211 @@
+#ifndef AMYLASE_FENWICK_TREES_HPP
+#define AMYLASE_FENWICK_TREES_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <atcoder/internal_type_traits>
+#include <amylase/internal_memory>
+
+namespace amylase {
+
+// Fenwick tree with range add and range sum.
+// As atcoder::fenwick_tree, integer sums are returned in mod 2^bit if overflowed.
+// It keeps b (a[i] = b[0] + ... + b[i]) in two fenwick trees:
+// a[0] + ... + a[r - 1] = r * (b[0] + ... + b[r - 1]) - (0 * b[0] + ... + (r - 1) * b[r - 1])
+template <class T> struct range_fenwick_tree {
+    using U = atcoder::internal::to_unsigned_t<T>;
+
+  public:
+    range_fenwick_tree() : _n(0) {}
+    range_fenwick_tree(int n) : _n(n), d0(n), d1(n) {}
+    range_fenwick_tree(const std::vector<T>& v) : _n(int(v.size())), d0(_n), d1(_n) {
+        for (int i = 0; i < _n; i++) {
+            U b = U(v[i]);
+            if (i > 0) b -= U(v[i - 1]);
+            d0[i] += b;
+            d1[i] += b * U(i);
+            int j = (i + 1) + ((i + 1) & -(i + 1));
+            if (j <= _n) {
+                d0[j - 1] += d0[i];
+                d1[j - 1] += d1[i];
+            }
+        }
+    }
+
+    // a[i] += x for i in [l, r)
+    void add(int l, int r, T x) {
+        assert(0 <= l && l <= r && r <= _n);
+        add(d0, l, U(x));
+        add(d1, l, U(x) * U(l));
+        add(d0, r, -U(x));
+        add(d1, r, -(U(x) * U(r)));
+    }
+    void add(int p, T x) {
+        assert(0 <= p && p < _n);
+        add(p, p + 1, x);
+    }
+
+    T sum(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        return T(sum(r) - sum(l));
+    }
+
+    T get(int p) {
+        assert(0 <= p && p < _n);
+        return sum(p, p + 1);
+    }
+
+  private:
+    int _n;
+    std::vector<U> d0, d1;
+
+    void add(std::vector<U>& d, int p, U x) {
+        p++;
+        while (p <= _n) {
+            d[p - 1] += x;
+            p += p & -p;
+        }
+    }
+
+    U sum(int r) {
+        U s0 = 0, s1 = 0;
+        for (int p = r; p > 0; p -= p & -p) {
+            s0 += d0[p - 1];
+            s1 += d1[p - 1];
+        }
+        return s0 * U(r) - s1;
+    }
+};
+
+// Point add / rectangle sum over a set of points given in advance.
+// Each fenwick node over x keeps a fenwick tree over the y of the points below it.
+// All the inner trees are laid out in one buffer. O(n log n) memory, O(log^2 n) per query.
+template <class Pos, class T> struct rectangle_fenwick_tree {
+    using U = atcoder::internal::to_unsigned_t<T>;
+
+  public:
+    rectangle_fenwick_tree() : rectangle_fenwick_tree(std::vector<std::pair<Pos, Pos>>()) {}
+    rectangle_fenwick_tree(const std::vector<std::pair<Pos, Pos>>& points) {
+        for (auto& p : points) xs.push_back(p.first);
+        std::sort(xs.begin(), xs.end());
+        xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+        _n = int(xs.size());
+
+        std::vector<int> count(_n + 1);
+        for (auto& p : points) {
+            for (int i = x_index(p.first) + 1; i <= _n; i += i & -i) count[i]++;
+        }
+        std::vector<int> start(_n + 2);
+        for (int i = 1; i <= _n; i++) start[i + 1] = start[i] + count[i];
+        std::vector<Pos> buf(start[_n + 1]);
+        std::vector<int> pos(start.begin(), start.end() - 1);
+        for (auto& p : points) {
+            for (int i = x_index(p.first) + 1; i <= _n; i += i & -i) buf[pos[i]++] = p.second;
+        }
+
+        offset = std::vector<int>(_n + 2);
+        for (int i = 1; i <= _n; i++) {
+            auto first = buf.begin() + start[i], last = buf.begin() + start[i + 1];
+            std::sort(first, last);
+            last = std::unique(first, last);
+            ys.insert(ys.end(), first, last);
+            offset[i + 1] = int(ys.size());
+        }
+        data = std::vector<U>(ys.size());
+    }
+
+    // @param (x, y) one of the points given to the constructor
+    void add(Pos x, Pos y, T w) {
+        int i = x_index(x);
+        assert(i < _n && xs[i] == x);
+        for (i++; i <= _n; i += i & -i) {
+            int m = offset[i + 1] - offset[i];
+            int j = y_index(i, y);
+            assert(j < m && ys[offset[i] + j] == y);
+            for (j++; j <= m; j += j & -j) data[offset[i] + j - 1] += U(w);
+        }
+    }
+
+    // @return the sum over the points in [xl, xr) x [yl, yr)
+    T sum(Pos xl, Pos xr, Pos yl, Pos yr) {
+        if (!(xl < xr) || !(yl < yr)) return T(0);
+        return T(sum(x_index(xr), yl, yr) - sum(x_index(xl), yl, yr));
+    }
+
+  private:
+    int _n;
+    std::vector<Pos> xs;
+    // ys[offset[i], offset[i + 1]): sorted y of the points under the fenwick node i
+    std::vector<int> offset;
+    std::vector<Pos> ys;
+    std::vector<U> data;
+
+    int x_index(Pos x) const {
+        return int(std::lower_bound(xs.begin(), xs.end(), x) - xs.begin());
+    }
+    int y_index(int i, Pos y) const {
+        return int(std::lower_bound(ys.begin() + offset[i], ys.begin() + offset[i + 1], y) -
+                   (ys.begin() + offset[i]));
+    }
+
+    // sum over x-index in [0, r) and y in [yl, yr)
+    U sum(int r, Pos yl, Pos yr) const {
+        U s = 0;
+        for (int i = r; i > 0; i -= i & -i) {
+            for (int j = y_index(i, yr); j > 0; j -= j & -j) s += data[offset[i] + j - 1];
+            for (int j = y_index(i, yl); j > 0; j -= j & -j) s -= data[offset[i] + j - 1];
+        }
+        return s;
+    }
+};
+
+// Fenwick tree for very large n, with the same add / sum as atcoder::fenwick_tree.
+// The nodes visited by add / sum are power-of-two strides apart, so they map to the same
+// cache sets and evict each other. Inserting an unused slot after every 2^10 nodes breaks
+// the strides (node k is stored at k + k / 2^10), for 0.1% more memory.
+// Pass huge_pages = true to ask for transparent huge pages (Linux), which cuts TLB misses;
+// it is worth it from around 10^7 elements.
+template <class T> struct padded_fenwick_tree {
+    using U = atcoder::internal::to_unsigned_t<T>;
+
+  public:
+    padded_fenwick_tree() : padded_fenwick_tree(0) {}
+    padded_fenwick_tree(int n, bool huge_pages = false)
+        : _n(n), data(std::size_t(slot(n)) + 1, huge_pages) {}
+
+    void add(int p, T x) {
+        assert(0 <= p && p < _n);
+        p++;
+        while (p <= _n) {
+            data[slot(p)] += U(x);
+            p += p & -p;
+        }
+    }
+
+    T sum(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        return T(sum(r) - sum(l));
+    }
+
+  private:
+    int _n;
+    internal::aligned_buffer<U> data;
+
+    static int slot(int k) { return k + (k >> 10); }
+
+    U sum(int r) {
+        U s = 0;
+        while (r > 0) {
+            s += data[slot(r)];
+            r -= r & -r;
+        }
+        return s;
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_FENWICK_TREES_HPP
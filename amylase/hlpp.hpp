@@ -0,0 +1,285 @@
+#ifndef AMYLASE_HLPP_HPP
+#define AMYLASE_HLPP_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+#include <atcoder/internal_queue>
+
+namespace amylase {
+
+// Maximum flow by the highest-label push-relabel algorithm, with the same interface as atcoder::mf_graph
+// (add_edge / get_edge / edges / change_edge / flow / min_cut), so that one can be replaced by the other.
+// Cap must be an integral type.
+//
+// The edges are kept in a list until the first flow, then frozen into a CSR array of arcs
+// (adding an edge afterwards unfreezes them). flow runs in two phases:
+// the excess of s (flow_limit) is pushed toward t, then the excess which cannot reach t is pushed back to s.
+// Each phase uses bucket lists of the labels, the gap heuristic, and a global relabeling by BFS
+// every O(n + m) work. O(n^2 sqrt(m)) time per flow.
+//
+// Reference:
+// B. Cherkassky and A. Goldberg,
+// On Implementing Push-Relabel Method for the Maximum Flow Problem
+template <class Cap> struct hlpp_graph {
+  public:
+    hlpp_graph() : _n(0) {}
+    explicit hlpp_graph(int n) : _n(n) {}
+
+    int add_edge(int from, int to, Cap cap) {
+        assert(0 <= from && from < _n);
+        assert(0 <= to && to < _n);
+        assert(0 <= cap);
+        unfreeze();
+        int m = int(list.size());
+        list.push_back(edge{from, to, cap, 0});
+        return m;
+    }
+
+    struct edge {
+        int from, to;
+        Cap cap, flow;
+    };
+
+    edge get_edge(int i) {
+        int m = int(list.size());
+        assert(0 <= i && i < m);
+        if (!frozen) return list[i];
+        const _arc& _e = arcs[pos[i]];
+        const _arc& _re = arcs[_e.rev];
+        return edge{list[i].from, list[i].to, _e.cap + _re.cap, _re.cap};
+    }
+    std::vector<edge> edges() {
+        int m = int(list.size());
+        std::vector<edge> result;
+        for (int i = 0; i < m; i++) {
+            result.push_back(get_edge(i));
+        }
+        return result;
+    }
+    void change_edge(int i, Cap new_cap, Cap new_flow) {
+        int m = int(list.size());
+        assert(0 <= i && i < m);
+        assert(0 <= new_flow && new_flow <= new_cap);
+        if (!frozen) {
+            list[i].cap = new_cap;
+            list[i].flow = new_flow;
+            return;
+        }
+        _arc& _e = arcs[pos[i]];
+        _e.cap = new_cap - new_flow;
+        arcs[_e.rev].cap = new_flow;
+    }
+
+    Cap flow(int s, int t) {
+        return flow(s, t, std::numeric_limits<Cap>::max());
+    }
+    Cap flow(int s, int t, Cap flow_limit) {
+        assert(0 <= s && s < _n);
+        assert(0 <= t && t < _n);
+        assert(s != t);
+        freeze();
+        excess.assign(_n, 0);
+        excess[s] = flow_limit;
+        discharge_all(t, -1);
+        Cap result = excess[t];
+        // excess is left only on the vertices which cannot reach t
+        excess[t] = 0;
+        discharge_all(s, t);
+        return result;
+    }
+
+    std::vector<bool> min_cut(int s) {
+        freeze();
+        std::vector<bool> visited(_n);
+        atcoder::internal::simple_queue<int> que;
+        que.push(s);
+        while (!que.empty()) {
+            int p = que.front();
+            que.pop();
+            visited[p] = true;
+            for (int i = start[p]; i < start[p + 1]; i++) {
+                const _arc& e = arcs[i];
+                if (e.cap && !visited[e.to]) {
+                    visited[e.to] = true;
+                    que.push(e.to);
+                }
+            }
+        }
+        return visited;
+    }
+
+  private:
+    int _n;
+    struct _arc {
+        int to, rev;
+        Cap cap;
+    };
+    // from and to of the edges; cap and flow only while not frozen
+    std::vector<edge> list;
+    bool frozen = false;
+    // the arcs from v are arcs[start[v]], ..., arcs[start[v + 1] - 1]; pos[i]: the arc of the i-th edge
+    std::vector<int> start, pos;
+    std::vector<_arc> arcs;
+
+    // working space of flow
+    std::vector<Cap> excess;
+    std::vector<int> label, current;
+    // active vertices: a stack per label; all vertices: a doubly linked list per label
+    std::vector<int> active_head, active_next;
+    std::vector<int> all_head, all_next, all_prev;
+    int max_active, max_all;
+    long long work;
+
+    void freeze() {
+        if (frozen) return;
+        int m = int(list.size());
+        start.assign(_n + 1, 0);
+        for (auto& e : list) {
+            start[e.from + 1]++;
+            start[e.to + 1]++;
+        }
+        for (int v = 0; v < _n; v++) start[v + 1] += start[v];
+        std::vector<int> counter(start.begin(), start.end() - 1);
+        arcs.resize(2 * m);
+        pos.resize(m);
+        for (int i = 0; i < m; i++) {
+            const edge& e = list[i];
+            int a = counter[e.from]++, b = counter[e.to]++;
+            arcs[a] = _arc{e.to, b, e.cap - e.flow};
+            arcs[b] = _arc{e.from, a, e.flow};
+            pos[i] = a;
+        }
+        frozen = true;
+    }
+    void unfreeze() {
+        if (!frozen) return;
+        for (int i = 0; i < int(list.size()); i++) list[i] = get_edge(i);
+        frozen = false;
+        arcs.clear();
+        pos.clear();
+    }
+
+    void activate(int v) {
+        active_next[v] = active_head[label[v]];
+        active_head[label[v]] = v;
+        max_active = std::max(max_active, label[v]);
+    }
+    void insert(int v) {
+        int k = label[v];
+        all_prev[v] = -1;
+        all_next[v] = all_head[k];
+        if (all_head[k] != -1) all_prev[all_head[k]] = v;
+        all_head[k] = v;
+        max_all = std::max(max_all, k);
+    }
+    void erase(int v) {
+        int k = label[v];
+        if (all_prev[v] != -1) {
+            all_next[all_prev[v]] = all_next[v];
+        } else {
+            all_head[k] = all_next[v];
+        }
+        if (all_next[v] != -1) all_prev[all_next[v]] = all_prev[v];
+    }
+
+    // labels are the distances to sink in the residual graph (n if unreachable)
+    void global_relabel(int sink, int blocked) {
+        std::fill(label.begin(), label.end(), _n);
+        std::fill(active_head.begin(), active_head.end(), -1);
+        std::fill(all_head.begin(), all_head.end(), -1);
+        max_active = max_all = 0;
+        atcoder::internal::simple_queue<int> que;
+        label[sink] = 0;
+        que.push(sink);
+        while (!que.empty()) {
+            int v = que.front();
+            que.pop();
+            insert(v);
+            if (v != sink && excess[v] > 0) activate(v);
+            for (int i = start[v]; i < start[v + 1]; i++) {
+                int w = arcs[i].to;
+                if (label[w] < _n || w == blocked || arcs[arcs[i].rev].cap == 0) continue;
+                label[w] = label[v] + 1;
+                que.push(w);
+            }
+        }
+        for (int v = 0; v < _n; v++) current[v] = start[v];
+        work = 0;
+    }
+
+    // Relabels v, whose arcs are all inadmissible. When v was the last vertex with its label,
+    // v and the vertices with larger labels cannot reach the sink anymore (gap).
+    void relabel(int v) {
+        int k = label[v];
+        erase(v);
+        if (all_head[k] == -1) {
+            for (int j = k + 1; j <= max_all; j++) {
+                for (int u = all_head[j]; u != -1; u = all_next[u]) label[u] = _n;
+                all_head[j] = -1;
+            }
+            max_all = k - 1;
+            label[v] = _n;
+            return;
+        }
+        int h = _n;
+        for (int i = start[v]; i < start[v + 1]; i++) {
+            if (arcs[i].cap > 0) h = std::min(h, label[arcs[i].to] + 1);
+        }
+        work += start[v + 1] - start[v] + 12;
+        label[v] = h;
+        current[v] = start[v];
+        if (h < _n) insert(v);
+    }
+
+    void discharge(int v) {
+        while (excess[v] > 0) {
+            if (current[v] == start[v + 1]) {
+                relabel(v);
+                if (label[v] >= _n) return;
+                continue;
+            }
+            _arc& e = arcs[current[v]];
+            if (e.cap > 0 && label[e.to] == label[v] - 1) {
+                Cap d = std::min(excess[v], e.cap);
+                e.cap -= d;
+                arcs[e.rev].cap += d;
+                excess[v] -= d;
+                // the sink has the label 0, and is never activated
+                if (excess[e.to] == 0 && label[e.to] > 0) activate(e.to);
+                excess[e.to] += d;
+                if (excess[v] == 0) return;
+            }
+            current[v]++;
+        }
+    }
+
+    // Pushes all the excess toward sink, while it can reach sink.
+    // blocked (if not -1) never sends nor receives.
+    void discharge_all(int sink, int blocked) {
+        label.resize(_n);
+        current.resize(_n);
+        active_head.resize(_n);
+        active_next.resize(_n);
+        all_head.resize(_n);
+        all_next.resize(_n);
+        all_prev.resize(_n);
+        global_relabel(sink, blocked);
+        long long threshold = 6LL * _n + (long long)arcs.size();
+        while (true) {
+            while (max_active > 0 && active_head[max_active] == -1) max_active--;
+            if (max_active == 0) break;
+            int v = active_head[max_active];
+            active_head[max_active] = active_next[v];
+            // skip the vertices cut off by a gap
+            if (label[v] >= _n) continue;
+            discharge(v);
+            if (work > threshold) global_relabel(sink, blocked);
+        }
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_HLPP_HPP
@@ -0,0 +1,406 @@
+#ifndef AMYLASE_INCREMENTAL_SCC_HPP
+#define AMYLASE_INCREMENTAL_SCC_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+#include <atcoder/dsu>
+#include <atcoder/internal_scc>
+
+namespace amylase {
+
+// Strongly connected components of a graph under edge insertions.
+// The components are contracted with a dsu and kept in a topological order. When an edge goes
+// backward in the order, only the components between its endpoints are searched: the ones which
+// reach the tail and are reachable from the head are merged, and the others are reordered.
+// Reference:
+// David J. Pearce and Paul H. J. Kelly,
+// A Dynamic Topological Sort Algorithm for Directed Acyclic Graphs
+struct incremental_scc {
+  public:
+    incremental_scc() : _n(0) {}
+    incremental_scc(int n)
+        : _n(n), _components(n), uf(n), ord(n), at(n), out(n), in(n), mark(n, 0) {
+        for (int i = 0; i < n; i++) ord[i] = at[i] = i;
+    }
+
+    // When the searches cost more than twice the width of the affected range of the order,
+    // the components in the range are recomputed by Tarjan's algorithm instead.
+    // @return true if some components are merged, i.e. a new cycle is formed
+    bool add_edge(int from, int to) {
+        assert(0 <= from && from < _n);
+        assert(0 <= to && to < _n);
+        if (!insert(from, to)) return false;
+        int x = uf.leader(from), y = uf.leader(to);
+        long long budget = 2LL * (ord[x] - ord[y] + 1);
+        int res = repair(x, y, budget);
+        if (res != -1) return res == 1;
+        return recompute(ord[y], ord[x]);
+    }
+
+    // Adds the edges at once. The backward ones are handled as add_edge while the searches are
+    // cheap, with one budget for all of them; when it runs out, the components in the affected
+    // range of the order are recomputed by Tarjan's algorithm instead.
+    // @return true if some components are merged
+    bool add_edges(const std::vector<std::pair<int, int>>& edges) {
+        // the forward edges keep the order, and the backward ones are inserted one by one,
+        // because the searches assume that the order is topological
+        std::vector<std::pair<int, int>> backward;
+        int lo = _n, hi = -1;
+        for (auto e : edges) {
+            assert(0 <= e.first && e.first < _n);
+            assert(0 <= e.second && e.second < _n);
+            int x = uf.leader(e.first), y = uf.leader(e.second);
+            if (x == y) continue;
+            if (ord[x] < ord[y]) {
+                insert(e.first, e.second);
+            } else {
+                backward.push_back(e);
+                lo = std::min(lo, ord[y]), hi = std::max(hi, ord[x]);
+            }
+        }
+        bool merged = false;
+        long long budget = 2LL * (hi - lo + 1);
+        for (int i = 0; i < int(backward.size()); i++) {
+            if (!insert(backward[i].first, backward[i].second)) continue;
+            int res = repair(uf.leader(backward[i].first), uf.leader(backward[i].second), budget);
+            if (res != -1) {
+                merged |= res == 1;
+                continue;
+            }
+            for (int j = i + 1; j < int(backward.size()); j++) insert(backward[j].first, backward[j].second);
+            lo = _n, hi = -1;
+            for (int j = i; j < int(backward.size()); j++) {
+                int x = uf.leader(backward[j].first), y = uf.leader(backward[j].second);
+                if (x != y && ord[x] > ord[y]) lo = std::min(lo, ord[y]), hi = std::max(hi, ord[x]);
+            }
+            if (hi != -1) merged |= recompute(lo, hi);
+            break;
+        }
+        return merged;
+    }
+
+    int leader(int v) {
+        assert(0 <= v && v < _n);
+        return uf.leader(v);
+    }
+
+    bool same(int u, int v) {
+        assert(0 <= u && u < _n);
+        assert(0 <= v && v < _n);
+        return uf.same(u, v);
+    }
+
+    int size(int v) {
+        assert(0 <= v && v < _n);
+        return uf.size(v);
+    }
+
+    // the number of the components
+    int components() const { return _components; }
+
+    // the components in a topological order, in the same form as atcoder::scc_graph::scc()
+    std::vector<std::vector<int>> scc() {
+        auto groups = uf.groups();
+        std::sort(groups.begin(), groups.end(), [&](const std::vector<int>& a, const std::vector<int>& b) {
+            return ord[uf.leader(a[0])] < ord[uf.leader(b[0])];
+        });
+        return groups;
+    }
+
+  private:
+    int _n, _components;
+    atcoder::dsu uf;
+    // ord[c]: position of the component led by c in the topological order, distinct among the leaders
+    // at[p]: the leader at position p, or -1
+    std::vector<int> ord, at;
+    // edges from / to the members of each component, by the vertex on the other side
+    std::vector<std::vector<int>> out, in;
+    // 1: reached forward, 2: reached backward
+    std::vector<char> mark;
+
+    // adds the edge to the lists
+    // @return true if it goes backward in the current order
+    bool insert(int from, int to) {
+        int x = uf.leader(from), y = uf.leader(to);
+        if (x == y) return false;
+        out[x].push_back(to);
+        in[y].push_back(from);
+        return ord[x] > ord[y];
+    }
+
+    // fixes the order for the edge x -> y between leaders by searching forward from y and
+    // backward from x, within the orders [ord[y], ord[x]]
+    // @param budget the number of the edges which may be looked at, decreased by the ones looked at
+    // @return 1 if some components are merged, 0 if not, and -1 if the budget runs out
+    // (then nothing is changed)
+    int repair(int x, int y, long long& budget) {
+        if (x == y || ord[x] < ord[y]) return 0;
+        int lo = ord[y], hi = ord[x];
+        std::vector<int> forward, backward;
+        bool ok = search(y, lo, hi, out, 1, budget, forward) && search(x, lo, hi, in, 2, budget, backward);
+        if (!ok) {
+            for (int c : forward) mark[c] = 0;
+            for (int c : backward) mark[c] = 0;
+            return -1;
+        }
+        bool cycle = mark[x] == 3;
+
+        // the searched components take the same set of orders: backward only, both (merged into one,
+        // which takes the first of their orders), then forward only
+        std::vector<int> slots;
+        for (int c : forward) slots.push_back(ord[c]);
+        for (int c : backward) {
+            if (mark[c] != 3) slots.push_back(ord[c]);
+        }
+        std::sort(slots.begin(), slots.end());
+        auto by_ord = [&](int a, int b) { return ord[a] < ord[b]; };
+        std::sort(forward.begin(), forward.end(), by_ord);
+        std::sort(backward.begin(), backward.end(), by_ord);
+
+        for (int p : slots) at[p] = -1;
+        int pos = 0;
+        for (int c : backward) {
+            if (mark[c] == 2) place(c, slots[pos++]);
+        }
+        if (cycle) {
+            int merged = x, first = slots[pos];
+            for (int c : forward) {
+                if (mark[c] != 3) continue;
+                pos++;
+                if (c != x) merged = merge(merged, c);
+            }
+            place(merged, first);
+        }
+        for (int c : forward) {
+            if (mark[c] == 1) place(c, slots[pos++]);
+        }
+        for (int c : forward) mark[c] = 0;
+        for (int c : backward) mark[c] = 0;
+        return cycle ? 1 : 0;
+    }
+
+    // recomputes the components in the orders [lo, hi] by Tarjan's algorithm. The edges from
+    // outside of the range stay consistent with any order inside.
+    // @return true if some components are merged
+    bool recompute(int lo, int hi) {
+        std::vector<int> comps, slots;
+        for (int p = lo; p <= hi; p++) {
+            if (at[p] == -1) continue;
+            mark[at[p]] = 1;
+            ord[at[p]] = int(comps.size());  // temporarily the local index
+            comps.push_back(at[p]);
+            slots.push_back(p);
+        }
+        atcoder::internal::scc_graph g(int(comps.size()));
+        for (int c : comps) {
+            auto& list = out[c];
+            int k = 0;
+            for (int i = 0; i < int(list.size()); i++) {
+                int d = uf.leader(list[i]);
+                if (d == c) continue;
+                list[k++] = list[i];
+                if (mark[d]) g.add_edge(ord[c], ord[d]);
+            }
+            list.resize(k);
+        }
+        auto ids = g.scc_ids();
+        for (int c : comps) mark[c] = 0;
+        for (int p : slots) at[p] = -1;
+
+        // each group takes the first slot of its members, in the topological order of the groups
+        std::vector<int> merged(ids.first, -1);
+        for (int i = 0; i < int(comps.size()); i++) {
+            int j = ids.second[i];
+            merged[j] = merged[j] == -1 ? comps[i] : merge(merged[j], comps[i]);
+        }
+        std::vector<int> count(ids.first + 1);
+        for (int j : ids.second) count[j + 1]++;
+        for (int j = 0; j < ids.first; j++) {
+            count[j + 1] += count[j];
+            place(merged[j], slots[count[j]]);
+        }
+        return ids.first < int(comps.size());
+    }
+
+    // appends to visited the components reachable from s in g, among the ones with order in [lo, hi].
+    // The edges inside a component are removed from the lists on the way.
+    // @return false if the budget runs out
+    bool search(int s,
+                int lo,
+                int hi,
+                std::vector<std::vector<int>>& g,
+                char bit,
+                long long& budget,
+                std::vector<int>& visited) {
+        std::vector<int> stack = {s};
+        visited.push_back(s);
+        mark[s] |= bit;
+        while (!stack.empty()) {
+            int c = stack.back();
+            stack.pop_back();
+            auto& list = g[c];
+            if ((budget -= (long long)list.size()) < 0) return false;
+            int k = 0;
+            for (int i = 0; i < int(list.size()); i++) {
+                int d = uf.leader(list[i]);
+                if (d == c) continue;
+                list[k++] = list[i];
+                if ((mark[d] & bit) || ord[d] < lo || hi < ord[d]) continue;
+                mark[d] |= bit;
+                visited.push_back(d);
+                stack.push_back(d);
+            }
+            list.resize(k);
+        }
+        return true;
+    }
+
+    void place(int c, int p) {
+        ord[c] = p;
+        at[p] = c;
+    }
+
+    // merges the components led by a and b, together with their edge lists
+    int merge(int a, int b) {
+        int c = uf.merge(a, b);
+        int d = c == a ? b : a;
+        for (auto g : {&out, &in}) {
+            auto& big = (*g)[c];
+            auto& small = (*g)[d];
+            if (big.size() < small.size()) std::swap(big, small);
+            big.insert(big.end(), small.begin(), small.end());
+            std::vector<int>().swap(small);
+        }
+        _components--;
+        return c;
+    }
+};
+
+// Offline version: given all the edges in the order of insertion, it computes when each pair of
+// vertices becomes strongly connected, by divide and conquer over time with O(m log m) total
+// work in Tarjan's algorithm.
+struct offline_incremental_scc {
+  public:
+    offline_incremental_scc() : _n(0), _m(0) {}
+    offline_incremental_scc(int n, const std::vector<std::pair<int, int>>& edges)
+        : _n(n), _m(int(edges.size())), times(_m, -1), parent(n, -1), weight(n, -1), depth(n, 0) {
+        for (auto e : edges) {
+            assert(0 <= e.first && e.first < n);
+            assert(0 <= e.second && e.second < n);
+        }
+        atcoder::dsu uf(n);
+        std::vector<int> local(n, -1), ids(_m);
+        for (int i = 0; i < _m; i++) ids[i] = i;
+        solve(0, _m, ids, edges, uf, local);
+        build_tree(edges);
+    }
+
+    // @return the smallest k > i such that the endpoints of the i-th edge are strongly connected
+    // by the first k edges, or -1 if never
+    int edge_time(int i) const {
+        assert(0 <= i && i < _m);
+        return times[i];
+    }
+
+    // @return the smallest k such that a and b are strongly connected by the first k edges, or -1 if never
+    int pair_time(int a, int b) const {
+        assert(0 <= a && a < _n);
+        assert(0 <= b && b < _n);
+        // maximum weight on the path in the forest merged in the order of the times
+        int res = 0;
+        while (a != b) {
+            if (depth[a] < depth[b]) std::swap(a, b);
+            if (parent[a] == -1) return -1;
+            res = std::max(res, weight[a]);
+            a = parent[a];
+        }
+        return res;
+    }
+
+  private:
+    int _n, _m;
+    std::vector<int> times;
+    // the vertices are merged in the order of the times, with union by size and no path
+    // compression, so the depth is O(log n): weight[v] = time when v is linked below parent[v]
+    std::vector<int> parent, weight, depth;
+
+    // the edges in ids become strongly connected at time in [l, r] (r = m means never), and uf
+    // contracts the components at time l
+    void solve(int l,
+               int r,
+               const std::vector<int>& ids,
+               const std::vector<std::pair<int, int>>& edges,
+               atcoder::dsu& uf,
+               std::vector<int>& local) {
+        if (ids.empty()) return;
+        if (l == r) {
+            if (l == _m) return;
+            for (int i : ids) {
+                times[i] = l + 1;
+                uf.merge(edges[i].first, edges[i].second);
+            }
+            return;
+        }
+        int mid = (l + r) / 2;
+        // components at time mid, i.e. with the edges [0, mid]. The edges not in ids are already
+        // contracted, or not on any cycle at time mid.
+        std::vector<int> vs;
+        for (int i : ids) {
+            if (i > mid) break;
+            for (int v : {uf.leader(edges[i].first), uf.leader(edges[i].second)}) {
+                if (local[v] == -1) {
+                    local[v] = int(vs.size());
+                    vs.push_back(v);
+                }
+            }
+        }
+        atcoder::internal::scc_graph g(int(vs.size()));
+        for (int i : ids) {
+            if (i > mid) break;
+            g.add_edge(local[uf.leader(edges[i].first)], local[uf.leader(edges[i].second)]);
+        }
+        auto scc = g.scc_ids().second;
+        std::vector<int> left, right;
+        for (int i : ids) {
+            bool joined = i <= mid && scc[local[uf.leader(edges[i].first)]] == scc[local[uf.leader(edges[i].second)]];
+            (joined ? left : right).push_back(i);
+        }
+        for (int v : vs) local[v] = -1;
+        solve(l, mid, left, edges, uf, local);
+        solve(mid + 1, r, right, edges, uf, local);
+    }
+
+    void build_tree(const std::vector<std::pair<int, int>>& edges) {
+        std::vector<int> order;
+        for (int i = 0; i < _m; i++) {
+            if (times[i] != -1) order.push_back(i);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return times[a] < times[b]; });
+        std::vector<int> size(_n, 1);
+        auto root = [&](int v) {
+            while (parent[v] != -1) v = parent[v];
+            return v;
+        };
+        for (int i : order) {
+            int x = root(edges[i].first), y = root(edges[i].second);
+            if (x == y) continue;
+            if (size[x] < size[y]) std::swap(x, y);
+            parent[y] = x;
+            weight[y] = times[i];
+            size[x] += size[y];
+        }
+        for (int v = 0; v < _n; v++) depth[v] = calc_depth(v);
+    }
+
+    int calc_depth(int v) const {
+        int d = 0;
+        while (parent[v] != -1) v = parent[v], d++;
+        return d;
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_INCREMENTAL_SCC_HPP
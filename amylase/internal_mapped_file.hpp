@@ -0,0 +1,141 @@
+#ifndef AMYLASE_INTERNAL_MAPPED_FILE_HPP
+#define AMYLASE_INTERNAL_MAPPED_FILE_HPP 1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace amylase {
+
+namespace internal {
+
+// Whole contents of a file, mapped into memory with private (copy-on-write) pages.
+// Writes through data() are never written back to the file.
+// On Windows the file is read into a buffer instead.
+struct mapped_file {
+  public:
+    // @return nullptr on failure
+    static std::shared_ptr<mapped_file> open(const std::string& path) {
+        std::shared_ptr<mapped_file> file(new mapped_file());
+#ifdef _WIN32
+        std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+        if (!ifs) return nullptr;
+        file->buf.resize(std::size_t(ifs.tellg()));
+        ifs.seekg(0);
+        if (!ifs.read(file->buf.data(), std::streamsize(file->buf.size()))) return nullptr;
+        file->addr = file->buf.data();
+        file->length = file->buf.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return nullptr;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            return nullptr;
+        }
+        file->length = std::size_t(st.st_size);
+        void* addr = mmap(nullptr, file->length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) return nullptr;
+        file->addr = static_cast<char*>(addr);
+#endif
+        return file;
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    ~mapped_file() {
+#ifndef _WIN32
+        if (addr) munmap(addr, length);
+#endif
+    }
+
+    char* data() { return addr; }
+    std::size_t size() const { return length; }
+
+  private:
+    char* addr = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    std::vector<char> buf;
+#endif
+
+    mapped_file() {}
+};
+
+// Array which either owns its elements or points into a mapped_file.
+// Copies always own their elements.
+template <class T> struct mapped_array {
+  public:
+    mapped_array() : ptr(nullptr), len(0) {}
+    mapped_array(int n, const T& x) : own(n, x), ptr(own.data()), len(n) {}
+    mapped_array(std::shared_ptr<mapped_file> _file, std::size_t offset, int n)
+        : ptr(reinterpret_cast<T*>(_file->data() + offset)), len(n), file(_file) {}
+
+    mapped_array(const mapped_array& other)
+        : own(other.ptr, other.ptr + other.len), ptr(own.data()), len(other.len) {}
+    mapped_array(mapped_array&& other) noexcept
+        : own(std::move(other.own)), ptr(other.ptr), len(other.len), file(std::move(other.file)) {
+        other.ptr = nullptr;
+        other.len = 0;
+    }
+    mapped_array& operator=(mapped_array other) noexcept {
+        std::swap(own, other.own);
+        std::swap(ptr, other.ptr);
+        std::swap(len, other.len);
+        std::swap(file, other.file);
+        return *this;
+    }
+
+    T& operator[](int i) { return ptr[i]; }
+    const T& operator[](int i) const { return ptr[i]; }
+    const T* data() const { return ptr; }
+    int size() const { return len; }
+
+  private:
+    std::vector<T> own;
+    T* ptr;
+    int len;
+    std::shared_ptr<mapped_file> file;
+};
+
+// @return the smallest multiple of 64 which is not less than x
+constexpr std::size_t align64(std::size_t x) { return (x + 63) / 64 * 64; }
+
+// @return whether an array of `bytes` bytes at `offset` is aligned and lies in a file of `file_size` bytes,
+// without overflow for any offset read from a file
+inline bool fits_in_file(std::uint64_t offset, std::uint64_t bytes, std::uint64_t file_size) {
+    return offset % 64 == 0 && offset <= file_size && bytes <= file_size - offset;
+}
+
+// writes `size` bytes of `data` at `offset`, padding with zeros after the current position
+inline bool write_at(std::FILE* fp, std::size_t& pos, std::size_t offset, const void* data, std::size_t size) {
+    static const char zeros[64] = {};
+    while (pos < offset) {
+        std::size_t k = std::min<std::size_t>(offset - pos, sizeof(zeros));
+        if (std::fwrite(zeros, 1, k, fp) != k) return false;
+        pos += k;
+    }
+    if (size > 0 && std::fwrite(data, 1, size, fp) != size) return false;
+    pos += size;
+    return true;
+}
+
+}  // namespace internal
+
+}  // namespace amylase
+
+#endif  // AMYLASE_INTERNAL_MAPPED_FILE_HPP
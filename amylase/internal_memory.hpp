@@ -0,0 +1,80 @@
+#ifndef AMYLASE_INTERNAL_MEMORY_HPP
+#define AMYLASE_INTERNAL_MEMORY_HPP 1
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace amylase {
+
+namespace internal {
+
+// Fixed size array of value-initialized T, aligned to a cache line.
+// With huge_pages, the array is aligned to 2 MiB and the kernel is asked to back it
+// with transparent huge pages (Linux only; elsewhere the hint is ignored).
+template <class T> struct aligned_buffer {
+    static_assert(std::is_trivially_destructible<T>::value, "T must be trivially destructible");
+
+  public:
+    aligned_buffer() : ptr(nullptr), len(0) {}
+    aligned_buffer(std::size_t n, bool huge_pages = false) : ptr(nullptr), len(n) {
+        if (n == 0) return;
+        std::size_t alignment = huge_pages ? (std::size_t(1) << 21) : 64;
+        std::size_t bytes = (n * sizeof(T) + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+        void* p = _aligned_malloc(bytes, alignment);
+        if (!p) throw std::bad_alloc();
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, alignment, bytes) != 0) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+        if (huge_pages) madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+#endif
+        ptr = static_cast<T*>(p);
+        for (std::size_t i = 0; i < n; i++) new (ptr + i) T();
+    }
+
+    aligned_buffer(const aligned_buffer&) = delete;
+    aligned_buffer& operator=(const aligned_buffer&) = delete;
+    aligned_buffer(aligned_buffer&& other) noexcept : ptr(other.ptr), len(other.len) {
+        other.ptr = nullptr;
+        other.len = 0;
+    }
+    aligned_buffer& operator=(aligned_buffer&& other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(len, other.len);
+        return *this;
+    }
+    ~aligned_buffer() {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    T& operator[](std::size_t i) { return ptr[i]; }
+    const T& operator[](std::size_t i) const { return ptr[i]; }
+    T* data() { return ptr; }
+    std::size_t size() const { return len; }
+
+  private:
+    T* ptr;
+    std::size_t len;
+};
+
+}  // namespace internal
+
+}  // namespace amylase
+
+#endif  // AMYLASE_INTERNAL_MEMORY_HPP
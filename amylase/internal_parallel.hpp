@@ -0,0 +1,45 @@
+#ifndef AMYLASE_INTERNAL_PARALLEL_HPP
+#define AMYLASE_INTERNAL_PARALLEL_HPP 1
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace amylase {
+
+namespace internal {
+
+// @return threads, or the number of hardware threads if threads <= 0
+inline int resolve_threads(int threads) {
+    if (threads > 0) return threads;
+    return std::max(1, int(std::thread::hardware_concurrency()));
+}
+
+// Calls f(l, r) for disjoint ranges [l, r) covering [0, n), from `threads` threads
+// (including the calling one). The ranges of `grain` indices are handed out dynamically,
+// so that skewed work is balanced.
+template <class F> void parallel_for(long long n, int threads, F f, long long grain = 1 << 12) {
+    if (threads <= 1 || n <= grain) {
+        if (n > 0) f(0LL, n);
+        return;
+    }
+    std::atomic<long long> next(0);
+    auto worker = [&]() {
+        while (true) {
+            long long l = next.fetch_add(grain, std::memory_order_relaxed);
+            if (l >= n) return;
+            f(l, std::min(n, l + grain));
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(worker);
+    worker();
+    for (auto& w : workers) w.join();
+}
+
+}  // namespace internal
+
+}  // namespace amylase
+
+#endif  // AMYLASE_INTERNAL_PARALLEL_HPP
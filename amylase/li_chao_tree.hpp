@@ -0,0 +1,271 @@
+#ifndef AMYLASE_LI_CHAO_TREE_HPP
+#define AMYLASE_LI_CHAO_TREE_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace amylase {
+
+// All structures in this file answer min_i (a_i * x + b_i).
+// Negate a, b and the answer for max.
+
+// Li Chao tree over the query coordinates xs given in advance.
+// add_line / add_segment: O(log n) / O(log^2 n), get: O(log n).
+template <class T> struct li_chao_tree {
+  public:
+    li_chao_tree() : li_chao_tree(std::vector<T>()) {}
+    li_chao_tree(const std::vector<T>& _xs) : xs(_xs) {
+        std::sort(xs.begin(), xs.end());
+        xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+        _n = int(xs.size());
+        size = 1;
+        while (size < _n) size <<= 1;
+        // padded coordinates repeat the last one, so that every node has a valid range
+        if (_n > 0) xs.resize(size, xs.back());
+        lines = std::vector<line>(2 * size, line{0, 0});
+        filled = std::vector<bool>(2 * size, false);
+    }
+
+    static T inf() { return std::numeric_limits<T>::max(); }
+
+    void add_line(T a, T b) {
+        if (_n == 0) return;
+        insert(1, 0, size, line{a, b});
+    }
+
+    // add a * x + b for x in [l, r)
+    void add_segment(T l, T r, T a, T b) {
+        line f{a, b};
+        int w = 1;  // width of the nodes at the current height
+        for (int lk = index(l) + size, rk = index(r) + size; lk < rk; lk >>= 1, rk >>= 1, w <<= 1) {
+            if (lk & 1) {
+                insert(lk, (lk - size / w) * w, (lk - size / w + 1) * w, f);
+                lk++;
+            }
+            if (rk & 1) {
+                --rk;
+                insert(rk, (rk - size / w) * w, (rk - size / w + 1) * w, f);
+            }
+        }
+    }
+
+    // @param x one of the coordinates given to the constructor
+    T get(T x) const {
+        int p = int(std::lower_bound(xs.begin(), xs.begin() + _n, x) - xs.begin());
+        assert(p < _n && xs[p] == x);
+        T res = inf();
+        for (p += size; p >= 1; p >>= 1) {
+            if (filled[p]) res = std::min(res, lines[p].eval(x));
+        }
+        return res;
+    }
+
+  private:
+    struct line {
+        T a, b;
+        T eval(T x) const { return a * x + b; }
+    };
+
+    int _n, size;
+    std::vector<T> xs;
+    std::vector<line> lines;
+    // whether lines[k] holds a line
+    std::vector<bool> filled;
+
+    int index(T x) const {
+        return int(std::lower_bound(xs.begin(), xs.begin() + _n, x) - xs.begin());
+    }
+
+    // node k covers xs[l, r)
+    void insert(int k, int l, int r, line f) {
+        while (true) {
+            if (!filled[k]) {
+                lines[k] = f;
+                filled[k] = true;
+                return;
+            }
+            int mid = (l + r) / 2;
+            bool left = f.eval(xs[l]) < lines[k].eval(xs[l]);
+            bool middle = f.eval(xs[mid]) < lines[k].eval(xs[mid]);
+            if (middle) std::swap(lines[k], f);
+            if (r - l == 1) return;
+            if (left != middle) {
+                k = 2 * k, r = mid;
+            } else {
+                k = 2 * k + 1, l = mid;
+            }
+        }
+    }
+};
+
+// Li Chao tree over the integer range [lo, hi), allocating nodes on demand from a pool.
+// Each add_line creates at most one node, and add_segment O(log (hi - lo)) nodes.
+template <class T> struct dynamic_li_chao_tree {
+  public:
+    dynamic_li_chao_tree(T _lo, T _hi) : lo(_lo), hi(_hi), root(-1) { assert(lo < hi); }
+
+    static T inf() { return std::numeric_limits<T>::max(); }
+
+    void reserve(int n) { nodes.reserve(n); }
+
+    void add_line(T a, T b) { root = insert(root, lo, hi, line{a, b}); }
+
+    // add a * x + b for x in [l, r)
+    void add_segment(T l, T r, T a, T b) {
+        l = std::max(l, lo), r = std::min(r, hi);
+        if (l >= r) return;
+        root = insert_segment(root, lo, hi, l, r, line{a, b});
+    }
+
+    T get(T x) const {
+        assert(lo <= x && x < hi);
+        T res = inf();
+        int k = root;
+        T l = lo, r = hi;
+        while (k != -1) {
+            if (nodes[k].filled) res = std::min(res, nodes[k].f.eval(x));
+            T mid = l + (r - l) / 2;
+            if (x < mid) {
+                k = nodes[k].left, r = mid;
+            } else {
+                k = nodes[k].right, l = mid;
+            }
+        }
+        return res;
+    }
+
+  private:
+    struct line {
+        T a, b;
+        T eval(T x) const { return a * x + b; }
+    };
+    struct node {
+        line f;
+        int left, right;
+        // false for the nodes created on the way of add_segment, until a line is put
+        bool filled;
+    };
+
+    T lo, hi;
+    int root;
+    std::vector<node> nodes;
+
+    int new_node(line f, bool filled = true) {
+        nodes.push_back(node{f, -1, -1, filled});
+        return int(nodes.size()) - 1;
+    }
+
+    // node k covers [l, r)
+    int insert(int k, T l, T r, line f) {
+        if (k == -1) return new_node(f);
+        int top = k;
+        while (true) {
+            if (!nodes[k].filled) {
+                nodes[k].f = f;
+                nodes[k].filled = true;
+                return top;
+            }
+            T mid = l + (r - l) / 2;
+            bool left = f.eval(l) < nodes[k].f.eval(l);
+            bool middle = f.eval(mid) < nodes[k].f.eval(mid);
+            if (middle) std::swap(nodes[k].f, f);
+            if (r - l == 1) return top;
+            int next;
+            if (left != middle) {
+                next = nodes[k].left, r = mid;
+                if (next == -1) {
+                    next = new_node(f);
+                    nodes[k].left = next;
+                    return top;
+                }
+            } else {
+                next = nodes[k].right, l = mid;
+                if (next == -1) {
+                    next = new_node(f);
+                    nodes[k].right = next;
+                    return top;
+                }
+            }
+            k = next;
+        }
+    }
+
+    // add f to [ql, qr) under node k covering [l, r)
+    int insert_segment(int k, T l, T r, T ql, T qr, line f) {
+        if (r <= ql || qr <= l) return k;
+        if (ql <= l && r <= qr) return insert(k, l, r, f);
+        if (k == -1) k = new_node(line{0, 0}, false);
+        T mid = l + (r - l) / 2;
+        int left = insert_segment(nodes[k].left, l, mid, ql, qr, f);
+        nodes[k].left = left;
+        int right = insert_segment(nodes[k].right, mid, r, ql, qr, f);
+        nodes[k].right = right;
+        return k;
+    }
+};
+
+// Convex hull trick for lines added in non-increasing order of slope.
+// add_line: amortized O(1), get: O(log n), get_monotone: amortized O(1).
+template <class T> struct monotone_cht {
+  public:
+    void add_line(T a, T b) {
+        assert(lines.empty() || a <= lines.back().a);
+        if (!lines.empty() && lines.back().a == a) {
+            if (lines.back().b <= b) return;
+            lines.pop_back();
+        }
+        line f{a, b};
+        while (lines.size() >= 2 && bad(lines[lines.size() - 2], lines.back(), f)) lines.pop_back();
+        lines.push_back(f);
+    }
+
+    bool empty() const { return lines.empty(); }
+
+    T get(T x) const {
+        assert(!lines.empty());
+        int l = 0, r = int(lines.size()) - 1;
+        while (l < r) {
+            int mid = (l + r) / 2;
+            if (lines[mid].eval(x) <= lines[mid + 1].eval(x)) r = mid;
+            else l = mid + 1;
+        }
+        return lines[l].eval(x);
+    }
+
+    // x must be non-decreasing over the calls. The lines which cannot be the minimum anymore are discarded.
+    T get_monotone(T x) {
+        assert(!lines.empty());
+        while (lines.size() >= 2 && lines[1].eval(x) <= lines[0].eval(x)) lines.pop_front();
+        return lines[0].eval(x);
+    }
+
+  private:
+    struct line {
+        T a, b;
+        T eval(T x) const { return a * x + b; }
+    };
+    std::deque<line> lines;
+
+    // The cross products of bad(). For integral T they are exact in __int128 with |a|, |b| < 2^62,
+    // and for floating-point T they are computed in long double. MSVC has no __int128, and its
+    // long double is double: there they are rounded to 53 bits, so lines which almost meet at
+    // one point may be misjudged.
+#ifndef _MSC_VER
+    using wide = typename std::conditional<std::is_integral<T>::value, __int128, long double>::type;
+#else
+    using wide = long double;
+#endif
+
+    // g is unnecessary if f and h cross at or below g (f.a > g.a > h.a).
+    static bool bad(const line& f, const line& g, const line& h) {
+        return ((wide)g.b - f.b) * ((wide)f.a - h.a) >= ((wide)h.b - f.b) * ((wide)f.a - g.a);
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_LI_CHAO_TREE_HPP
@@ -0,0 +1,402 @@
+#ifndef AMYLASE_MAPPED_SEGTREE_HPP
+#define AMYLASE_MAPPED_SEGTREE_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <atcoder/internal_bit>
+#include <amylase/internal_mapped_file>
+
+namespace amylase {
+
+// atcoder::segtree / atcoder::lazy_segtree which can be saved to a file and
+// reopened by mmap, without rebuilding the tree.
+//
+// File format (version 1, native endianness):
+//   snapshot_header, then the node array `d` at d_offset and (lazy only)
+//   the lazy array `lz` at lz_offset. Both offsets are multiples of 64.
+// open_mapped maps the file with copy-on-write pages: the tree can be updated
+// afterwards, and the updates are never written back to the file.
+struct snapshot_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t lazy;
+    std::uint64_t s_size, f_size;
+    std::int64_t n;
+    std::uint64_t d_offset, lz_offset;
+
+    static constexpr std::uint32_t current_version = 1;
+
+    static snapshot_header make(bool _lazy, std::size_t _s_size, std::size_t _f_size, int _n, int size) {
+        snapshot_header h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "AMYLSEG", 8);
+        h.version = current_version;
+        h.lazy = _lazy;
+        h.s_size = _s_size;
+        h.f_size = _f_size;
+        h.n = _n;
+        h.d_offset = internal::align64(sizeof(snapshot_header));
+        h.lz_offset = _lazy ? internal::align64(h.d_offset + _s_size * 2 * size) : 0;
+        return h;
+    }
+
+    // @return whether the header matches the given parameters and fits in a file of `file_size` bytes
+    bool valid(bool _lazy, std::size_t _s_size, std::size_t _f_size, std::size_t file_size) const {
+        if (std::memcmp(magic, "AMYLSEG", 8) != 0) return false;
+        if (version != current_version || lazy != std::uint32_t(_lazy)) return false;
+        if (s_size != _s_size || f_size != _f_size) return false;
+        // the 2 * size nodes must be indexable by int, i.e. size <= 2^29
+        if (n < 0 || n > (1 << 29)) return false;
+        std::uint64_t size = std::uint64_t(1) << atcoder::internal::ceil_pow2(int(n));
+        if (!internal::fits_in_file(d_offset, s_size * 2 * size, file_size)) return false;
+        if (_lazy && !internal::fits_in_file(lz_offset, f_size * size, file_size)) return false;
+        return true;
+    }
+};
+
+template <class S, S (*op)(S, S), S (*e)()> struct mapped_segtree {
+    static_assert(std::is_trivially_copyable<S>::value, "S must be trivially copyable");
+
+  public:
+    mapped_segtree() : mapped_segtree(0) {}
+    mapped_segtree(int n) : mapped_segtree(std::vector<S>(n, e())) {}
+    mapped_segtree(const std::vector<S>& v) : _n(int(v.size())) {
+        log = atcoder::internal::ceil_pow2(_n);
+        size = 1 << log;
+        d = internal::mapped_array<S>(2 * size, e());
+        for (int i = 0; i < _n; i++) d[size + i] = v[i];
+        for (int i = size - 1; i >= 1; i--) {
+            update(i);
+        }
+    }
+
+    // @return false if the file could not be written
+    bool save(const std::string& path) const {
+        snapshot_header h = snapshot_header::make(false, sizeof(S), 0, _n, size);
+        std::FILE* fp = std::fopen(path.c_str(), "wb");
+        if (!fp) return false;
+        std::size_t pos = 0;
+        bool ok = internal::write_at(fp, pos, 0, &h, sizeof(h)) &&
+                  internal::write_at(fp, pos, h.d_offset, d.data(), sizeof(S) * d.size());
+        return (std::fclose(fp) == 0) && ok;
+    }
+
+    // Replaces this tree with the one saved in `path`.
+    // @return false (and this tree is unchanged) if the file is missing or was saved by another instantiation
+    bool open_mapped(const std::string& path) {
+        auto file = internal::mapped_file::open(path);
+        if (!file || file->size() < sizeof(snapshot_header)) return false;
+        snapshot_header h;
+        std::memcpy(&h, file->data(), sizeof(h));
+        if (!h.valid(false, sizeof(S), 0, file->size())) return false;
+        _n = int(h.n);
+        log = atcoder::internal::ceil_pow2(_n);
+        size = 1 << log;
+        d = internal::mapped_array<S>(file, h.d_offset, 2 * size);
+        return true;
+    }
+
+    void set(int p, S x) {
+        assert(0 <= p && p < _n);
+        p += size;
+        d[p] = x;
+        for (int i = 1; i <= log; i++) update(p >> i);
+    }
+
+    S get(int p) const {
+        assert(0 <= p && p < _n);
+        return d[p + size];
+    }
+
+    S prod(int l, int r) const {
+        assert(0 <= l && l <= r && r <= _n);
+        S sml = e(), smr = e();
+        l += size;
+        r += size;
+
+        while (l < r) {
+            if (l & 1) sml = op(sml, d[l++]);
+            if (r & 1) smr = op(d[--r], smr);
+            l >>= 1;
+            r >>= 1;
+        }
+        return op(sml, smr);
+    }
+
+    S all_prod() const { return d[1]; }
+
+    template <bool (*f)(S)> int max_right(int l) const {
+        return max_right(l, [](S x) { return f(x); });
+    }
+    template <class F> int max_right(int l, F f) const {
+        assert(0 <= l && l <= _n);
+        assert(f(e()));
+        if (l == _n) return _n;
+        l += size;
+        S sm = e();
+        do {
+            while (l % 2 == 0) l >>= 1;
+            if (!f(op(sm, d[l]))) {
+                while (l < size) {
+                    l = (2 * l);
+                    if (f(op(sm, d[l]))) {
+                        sm = op(sm, d[l]);
+                        l++;
+                    }
+                }
+                return l - size;
+            }
+            sm = op(sm, d[l]);
+            l++;
+        } while ((l & -l) != l);
+        return _n;
+    }
+
+    template <bool (*f)(S)> int min_left(int r) const {
+        return min_left(r, [](S x) { return f(x); });
+    }
+    template <class F> int min_left(int r, F f) const {
+        assert(0 <= r && r <= _n);
+        assert(f(e()));
+        if (r == 0) return 0;
+        r += size;
+        S sm = e();
+        do {
+            r--;
+            while (r > 1 && (r % 2)) r >>= 1;
+            if (!f(op(d[r], sm))) {
+                while (r < size) {
+                    r = (2 * r + 1);
+                    if (f(op(d[r], sm))) {
+                        sm = op(d[r], sm);
+                        r--;
+                    }
+                }
+                return r + 1 - size;
+            }
+            sm = op(d[r], sm);
+        } while ((r & -r) != r);
+        return 0;
+    }
+
+  private:
+    int _n, size, log;
+    internal::mapped_array<S> d;
+
+    void update(int k) { d[k] = op(d[2 * k], d[2 * k + 1]); }
+};
+
+template <class S,
+          S (*op)(S, S),
+          S (*e)(),
+          class F,
+          S (*mapping)(F, S),
+          F (*composition)(F, F),
+          F (*id)()>
+struct mapped_lazy_segtree {
+    static_assert(std::is_trivially_copyable<S>::value, "S must be trivially copyable");
+    static_assert(std::is_trivially_copyable<F>::value, "F must be trivially copyable");
+
+  public:
+    mapped_lazy_segtree() : mapped_lazy_segtree(0) {}
+    mapped_lazy_segtree(int n) : mapped_lazy_segtree(std::vector<S>(n, e())) {}
+    mapped_lazy_segtree(const std::vector<S>& v) : _n(int(v.size())) {
+        log = atcoder::internal::ceil_pow2(_n);
+        size = 1 << log;
+        d = internal::mapped_array<S>(2 * size, e());
+        lz = internal::mapped_array<F>(size, id());
+        for (int i = 0; i < _n; i++) d[size + i] = v[i];
+        for (int i = size - 1; i >= 1; i--) {
+            update(i);
+        }
+    }
+
+    // @return false if the file could not be written
+    bool save(const std::string& path) const {
+        snapshot_header h = snapshot_header::make(true, sizeof(S), sizeof(F), _n, size);
+        std::FILE* fp = std::fopen(path.c_str(), "wb");
+        if (!fp) return false;
+        std::size_t pos = 0;
+        bool ok = internal::write_at(fp, pos, 0, &h, sizeof(h)) &&
+                  internal::write_at(fp, pos, h.d_offset, d.data(), sizeof(S) * d.size()) &&
+                  internal::write_at(fp, pos, h.lz_offset, lz.data(), sizeof(F) * lz.size());
+        return (std::fclose(fp) == 0) && ok;
+    }
+
+    // Replaces this tree with the one saved in `path`.
+    // @return false (and this tree is unchanged) if the file is missing or was saved by another instantiation
+    bool open_mapped(const std::string& path) {
+        auto file = internal::mapped_file::open(path);
+        if (!file || file->size() < sizeof(snapshot_header)) return false;
+        snapshot_header h;
+        std::memcpy(&h, file->data(), sizeof(h));
+        if (!h.valid(true, sizeof(S), sizeof(F), file->size())) return false;
+        _n = int(h.n);
+        log = atcoder::internal::ceil_pow2(_n);
+        size = 1 << log;
+        d = internal::mapped_array<S>(file, h.d_offset, 2 * size);
+        lz = internal::mapped_array<F>(file, h.lz_offset, size);
+        return true;
+    }
+
+    void set(int p, S x) {
+        assert(0 <= p && p < _n);
+        p += size;
+        for (int i = log; i >= 1; i--) push(p >> i);
+        d[p] = x;
+        for (int i = 1; i <= log; i++) update(p >> i);
+    }
+
+    S get(int p) {
+        assert(0 <= p && p < _n);
+        p += size;
+        for (int i = log; i >= 1; i--) push(p >> i);
+        return d[p];
+    }
+
+    S prod(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        if (l == r) return e();
+
+        l += size;
+        r += size;
+
+        for (int i = log; i >= 1; i--) {
+            if (((l >> i) << i) != l) push(l >> i);
+            if (((r >> i) << i) != r) push(r >> i);
+        }
+
+        S sml = e(), smr = e();
+        while (l < r) {
+            if (l & 1) sml = op(sml, d[l++]);
+            if (r & 1) smr = op(d[--r], smr);
+            l >>= 1;
+            r >>= 1;
+        }
+
+        return op(sml, smr);
+    }
+
+    S all_prod() { return d[1]; }
+
+    void apply(int p, F f) {
+        assert(0 <= p && p < _n);
+        p += size;
+        for (int i = log; i >= 1; i--) push(p >> i);
+        d[p] = mapping(f, d[p]);
+        for (int i = 1; i <= log; i++) update(p >> i);
+    }
+    void apply(int l, int r, F f) {
+        assert(0 <= l && l <= r && r <= _n);
+        if (l == r) return;
+
+        l += size;
+        r += size;
+
+        for (int i = log; i >= 1; i--) {
+            if (((l >> i) << i) != l) push(l >> i);
+            if (((r >> i) << i) != r) push((r - 1) >> i);
+        }
+
+        {
+            int l2 = l, r2 = r;
+            while (l < r) {
+                if (l & 1) all_apply(l++, f);
+                if (r & 1) all_apply(--r, f);
+                l >>= 1;
+                r >>= 1;
+            }
+            l = l2;
+            r = r2;
+        }
+
+        for (int i = 1; i <= log; i++) {
+            if (((l >> i) << i) != l) update(l >> i);
+            if (((r >> i) << i) != r) update((r - 1) >> i);
+        }
+    }
+
+    template <bool (*g)(S)> int max_right(int l) {
+        return max_right(l, [](S x) { return g(x); });
+    }
+    template <class G> int max_right(int l, G g) {
+        assert(0 <= l && l <= _n);
+        assert(g(e()));
+        if (l == _n) return _n;
+        l += size;
+        for (int i = log; i >= 1; i--) push(l >> i);
+        S sm = e();
+        do {
+            while (l % 2 == 0) l >>= 1;
+            if (!g(op(sm, d[l]))) {
+                while (l < size) {
+                    push(l);
+                    l = (2 * l);
+                    if (g(op(sm, d[l]))) {
+                        sm = op(sm, d[l]);
+                        l++;
+                    }
+                }
+                return l - size;
+            }
+            sm = op(sm, d[l]);
+            l++;
+        } while ((l & -l) != l);
+        return _n;
+    }
+
+    template <bool (*g)(S)> int min_left(int r) {
+        return min_left(r, [](S x) { return g(x); });
+    }
+    template <class G> int min_left(int r, G g) {
+        assert(0 <= r && r <= _n);
+        assert(g(e()));
+        if (r == 0) return 0;
+        r += size;
+        for (int i = log; i >= 1; i--) push((r - 1) >> i);
+        S sm = e();
+        do {
+            r--;
+            while (r > 1 && (r % 2)) r >>= 1;
+            if (!g(op(d[r], sm))) {
+                while (r < size) {
+                    push(r);
+                    r = (2 * r + 1);
+                    if (g(op(d[r], sm))) {
+                        sm = op(d[r], sm);
+                        r--;
+                    }
+                }
+                return r + 1 - size;
+            }
+            sm = op(d[r], sm);
+        } while ((r & -r) != r);
+        return 0;
+    }
+
+  private:
+    int _n, size, log;
+    internal::mapped_array<S> d;
+    internal::mapped_array<F> lz;
+
+    void update(int k) { d[k] = op(d[2 * k], d[2 * k + 1]); }
+    void all_apply(int k, F f) {
+        d[k] = mapping(f, d[k]);
+        if (k < size) lz[k] = composition(f, lz[k]);
+    }
+    void push(int k) {
+        all_apply(2 * k, lz[k]);
+        all_apply(2 * k + 1, lz[k]);
+        lz[k] = id();
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_MAPPED_SEGTREE_HPP
@@ -0,0 +1,108 @@
+#ifndef AMYLASE_PARALLEL_COMPONENTS_HPP
+#define AMYLASE_PARALLEL_COMPONENTS_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <utility>
+#include <vector>
+#include <amylase/concurrent_dsu>
+#include <amylase/internal_parallel>
+
+namespace amylase {
+
+namespace internal {
+
+// ids[v] = index of the component of v, numbered in the order of the smallest vertices
+inline std::vector<int> component_ids(concurrent_dsu& uf, int n, int threads) {
+    std::vector<int> ids(n);
+    parallel_for(n, threads, [&](long long l, long long r) {
+        for (int v = int(l); v < int(r); v++) ids[v] = uf.leader(v);
+    });
+    // the leader of a component is its smallest vertex, which is relabeled first
+    int k = 0;
+    for (int v = 0; v < n; v++) ids[v] = ids[v] == v ? k++ : ids[ids[v]];
+    return ids;
+}
+
+}  // namespace internal
+
+// Connected components of an undirected graph given by an edge list, from multiple threads.
+// The edges are merged into a concurrent_dsu in parallel.
+// @param threads the number of threads, or <= 0 for the number of hardware threads
+// @return ids[v] = index of the component of v. The components are numbered in the order of
+// their smallest vertices, so the i-th group of `components_to_groups(ids)` contains ids^-1(i).
+inline std::vector<int> parallel_components(int n, const std::vector<std::pair<int, int>>& edges,
+                                            int threads = 0) {
+    threads = internal::resolve_threads(threads);
+    concurrent_dsu uf(n);
+    internal::parallel_for((long long)edges.size(), threads, [&](long long l, long long r) {
+        for (long long i = l; i < r; i++) {
+            assert(0 <= edges[i].first && edges[i].first < n);
+            assert(0 <= edges[i].second && edges[i].second < n);
+            uf.merge(edges[i].first, edges[i].second);
+        }
+    });
+    return internal::component_ids(uf, n, threads);
+}
+
+// Connected components of an undirected graph in CSR: the neighbors of v are
+// elist[start[v]], ..., elist[start[v + 1] - 1]. Each edge must be stored in both directions.
+//
+// Implement Afforest: first only the first `rounds` neighbors of each vertex are merged, which
+// usually forms one giant component. It is found by sampling, and the vertices inside it skip
+// their remaining neighbors (the edges going out of it are merged from the other side).
+// Reference:
+// Michael Sutton, Tal Ben-Nun and Amnon Barak,
+// Optimizing Parallel Graph Connectivity Computation via Subgraph Sampling
+inline std::vector<int> parallel_components(const std::vector<int>& start, const std::vector<int>& elist,
+                                            int threads = 0, int rounds = 2) {
+    assert(!start.empty());
+    threads = internal::resolve_threads(threads);
+    int n = int(start.size()) - 1;
+    concurrent_dsu uf(n);
+
+    for (int k = 0; k < rounds; k++) {
+        internal::parallel_for(n, threads, [&](long long l, long long r) {
+            for (int v = int(l); v < int(r); v++) {
+                if (start[v] + k < start[v + 1]) uf.merge(v, elist[start[v] + k]);
+            }
+        });
+    }
+
+    // the most frequent leader among the samples
+    int giant = -1;
+    if (n > 0) {
+        std::vector<int> samples(std::min(n, 1024));
+        std::mt19937 mt(n);
+        for (auto& s : samples) s = uf.leader(int(mt() % unsigned(n)));
+        std::sort(samples.begin(), samples.end());
+        int best = 0;
+        for (int i = 0, j = 0; i < int(samples.size()); i = j) {
+            while (j < int(samples.size()) && samples[j] == samples[i]) j++;
+            if (j - i > best) best = j - i, giant = samples[i];
+        }
+    }
+
+    internal::parallel_for(n, threads, [&](long long l, long long r) {
+        for (int v = int(l); v < int(r); v++) {
+            if (uf.leader(v) == giant) continue;
+            for (int i = start[v] + rounds; i < start[v + 1]; i++) uf.merge(v, elist[i]);
+        }
+    });
+    return internal::component_ids(uf, n, threads);
+}
+
+// Converts ids from parallel_components into the vertex lists of the components,
+// in the same form as atcoder::dsu::groups().
+inline std::vector<std::vector<int>> components_to_groups(const std::vector<int>& ids) {
+    int k = 0;
+    for (int x : ids) k = std::max(k, x + 1);
+    std::vector<std::vector<int>> groups(k);
+    for (int v = 0; v < int(ids.size()); v++) groups[ids[v]].push_back(v);
+    return groups;
+}
+
+}  // namespace amylase
+
+#endif  // AMYLASE_PARALLEL_COMPONENTS_HPP
@@ -0,0 +1,309 @@
+#ifndef AMYLASE_PARALLEL_SCC_HPP
+#define AMYLASE_PARALLEL_SCC_HPP 1
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <atcoder/internal_scc>
+#include <amylase/internal_parallel>
+
+namespace amylase {
+
+// Strongly connected components from multiple threads, in the same form as atcoder::scc_graph::scc():
+// the components are listed in a topological order, and the vertices of each one in increasing order.
+// The components are the same as the ones of scc(), but the topological order may differ.
+//
+// Implement Multistep:
+// 1. trim the vertices without in-edges or out-edges, which are components by themselves,
+// 2. find the component of a vertex with large degrees (usually the giant one) by forward-backward search,
+// 3. repeat coloring (max label propagation, then backward search from the roots of the colors)
+//    while many vertices remain and each round decides a good part of them, and
+// 4. run Tarjan's algorithm on the rest.
+// Reference:
+// George M. Slota, Sivasankaran Rajamanickam and Kamesh Madduri,
+// BFS and Coloring-based Parallel Algorithms for Strongly Connected Components and Related Problems
+struct parallel_scc_graph {
+  public:
+    parallel_scc_graph() : _n(0) {}
+    parallel_scc_graph(int n) : _n(n) {}
+
+    int num_vertices() const { return _n; }
+
+    void add_edge(int from, int to) {
+        assert(0 <= from && from < _n);
+        assert(0 <= to && to < _n);
+        edges.push_back({from, to});
+    }
+
+    // @param threads the number of threads, or <= 0 for the number of hardware threads
+    std::vector<std::vector<int>> scc(int threads = 0) {
+        threads = internal::resolve_threads(threads);
+        std::vector<std::pair<int, int>> redges(edges.size());
+        for (int i = 0; i < int(edges.size()); i++) redges[i] = {edges[i].second, edges[i].first};
+        atcoder::internal::csr<int> g(_n, edges), rg(_n, redges);
+        redges.clear();
+        redges.shrink_to_fit();
+
+        // comp[v]: some vertex of the component of v, or -1 if not decided yet
+        std::unique_ptr<std::atomic<int>[]> comp(new std::atomic<int>[_n]);
+        for (int v = 0; v < _n; v++) comp[v].store(-1, std::memory_order_relaxed);
+        auto alive = [&](int v) { return comp[v].load(std::memory_order_relaxed) == -1; };
+
+        trim(g, rg, comp.get(), threads);
+
+        std::vector<int> rest;
+        for (int v = 0; v < _n; v++) {
+            if (alive(v)) rest.push_back(v);
+        }
+        if (!rest.empty()) {
+            long long best = -1;
+            int pivot = -1;
+            for (int v : rest) {
+                long long d = (long long)(g.start[v + 1] - g.start[v]) * (rg.start[v + 1] - rg.start[v]);
+                if (d > best) best = d, pivot = v;
+            }
+            forward_backward(g, rg, comp.get(), pivot, threads);
+        }
+
+        std::unique_ptr<std::atomic<int>[]> color(new std::atomic<int>[_n]);
+        for (int v = 0; v < _n; v++) color[v].store(-1, std::memory_order_relaxed);
+        for (int last = -1;;) {
+            rest.erase(std::remove_if(rest.begin(), rest.end(), [&](int v) { return !alive(v); }),
+                       rest.end());
+            if (int(rest.size()) <= sequential_threshold) break;
+            // coloring may decide only one component per round (e.g. on a long chain of cycles)
+            if (last != -1 && (last - int(rest.size())) < last / 64) break;
+            last = int(rest.size());
+            if (!coloring(g, rg, comp.get(), color.get(), rest, threads)) break;
+        }
+
+        // Tarjan's algorithm on the subgraph induced by the rest
+        if (!rest.empty()) {
+            std::vector<int> local(_n, -1);
+            for (int i = 0; i < int(rest.size()); i++) local[rest[i]] = i;
+            atcoder::internal::scc_graph h(int(rest.size()));
+            for (int v : rest) {
+                for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+                    int to = g.elist[i];
+                    if (local[to] != -1) h.add_edge(local[v], local[to]);
+                }
+            }
+            for (auto& group : h.scc()) {
+                for (int x : group) comp[rest[x]].store(rest[group[0]], std::memory_order_relaxed);
+            }
+        }
+
+        return topological_groups(g, comp.get());
+    }
+
+  private:
+    int _n;
+    std::vector<std::pair<int, int>> edges;
+
+    // below this number of undecided vertices, Tarjan's algorithm is used
+    static constexpr int sequential_threshold = 1 << 12;
+
+    using graph = atcoder::internal::csr<int>;
+    using frontier = std::vector<int>;
+
+    // runs f(v, push) for each v in cur from multiple threads, and returns the pushed vertices
+    template <class F> static frontier expand(const frontier& cur, int threads, F f) {
+        frontier next;
+        std::mutex mtx;
+        internal::parallel_for(
+            (long long)cur.size(), threads,
+            [&](long long l, long long r) {
+                frontier buf;
+                auto push = [&](int v) { buf.push_back(v); };
+                for (long long i = l; i < r; i++) f(cur[i], push);
+                std::lock_guard<std::mutex> lock(mtx);
+                next.insert(next.end(), buf.begin(), buf.end());
+            },
+            1 << 8);
+        return next;
+    }
+
+    // decides the vertices which become without in-edges or out-edges when
+    // such vertices are removed repeatedly
+    void trim(const graph& g, const graph& rg, std::atomic<int>* comp, int threads) const {
+        // the numbers of in-edges and out-edges from the other vertices not removed yet
+        std::unique_ptr<std::atomic<int>[]> indeg(new std::atomic<int>[_n]), outdeg(new std::atomic<int>[_n]);
+        frontier cur;
+        for (int v = 0; v < _n; v++) {
+            int in = 0, out = 0;
+            for (int i = rg.start[v]; i < rg.start[v + 1]; i++) in += rg.elist[i] != v;
+            for (int i = g.start[v]; i < g.start[v + 1]; i++) out += g.elist[i] != v;
+            indeg[v].store(in, std::memory_order_relaxed);
+            outdeg[v].store(out, std::memory_order_relaxed);
+            if (in == 0 || out == 0) {
+                comp[v].store(v, std::memory_order_relaxed);
+                cur.push_back(v);
+            }
+        }
+        auto claim = [&](int v) {
+            int expected = -1;
+            return comp[v].compare_exchange_strong(expected, v, std::memory_order_relaxed);
+        };
+        while (!cur.empty()) {
+            cur = expand(cur, threads, [&](int v, auto push) {
+                for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+                    int w = g.elist[i];
+                    if (w != v && indeg[w].fetch_sub(1, std::memory_order_relaxed) == 1 && claim(w)) push(w);
+                }
+                for (int i = rg.start[v]; i < rg.start[v + 1]; i++) {
+                    int u = rg.elist[i];
+                    if (u != v && outdeg[u].fetch_sub(1, std::memory_order_relaxed) == 1 && claim(u)) push(u);
+                }
+            });
+        }
+    }
+
+    // decides the component of the pivot, which is the intersection of its forward and backward reach
+    void forward_backward(const graph& g, const graph& rg, std::atomic<int>* comp, int pivot, int threads) const {
+        // 0: not visited, 1: reached forward, 2: reached both ways
+        std::unique_ptr<std::atomic<char>[]> mark(new std::atomic<char>[_n]);
+        for (int v = 0; v < _n; v++) mark[v].store(0, std::memory_order_relaxed);
+        auto visit = [&](int v, char from, char to) {
+            char expected = from;
+            return mark[v].compare_exchange_strong(expected, to, std::memory_order_relaxed);
+        };
+        mark[pivot].store(1, std::memory_order_relaxed);
+        frontier cur = {pivot};
+        while (!cur.empty()) {
+            cur = expand(cur, threads, [&](int v, auto push) {
+                for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+                    int w = g.elist[i];
+                    if (comp[w].load(std::memory_order_relaxed) == -1 && visit(w, 0, 1)) push(w);
+                }
+            });
+        }
+        // the paths to the pivot from the component stay in the component, so in the forward reach
+        mark[pivot].store(2, std::memory_order_relaxed);
+        comp[pivot].store(pivot, std::memory_order_relaxed);
+        cur = {pivot};
+        while (!cur.empty()) {
+            cur = expand(cur, threads, [&](int v, auto push) {
+                for (int i = rg.start[v]; i < rg.start[v + 1]; i++) {
+                    int u = rg.elist[i];
+                    if (visit(u, 1, 2)) {
+                        comp[u].store(pivot, std::memory_order_relaxed);
+                        push(u);
+                    }
+                }
+            });
+        }
+    }
+
+    // propagates the maximum label forward; then the vertices with their own label are the roots,
+    // and the component of a root is what reaches it backward within the same color.
+    // @return false if the propagation is given up (labels can move one edge per round, so
+    // long paths cost O(n) times each), in which case nothing is decided
+    bool coloring(const graph& g,
+                  const graph& rg,
+                  std::atomic<int>* comp,
+                  std::atomic<int>* color,
+                  const std::vector<int>& rest,
+                  int threads) const {
+        for (int v : rest) color[v].store(v, std::memory_order_relaxed);
+        frontier cur = rest;
+        // pushes each vertex at most once per round
+        std::unique_ptr<std::atomic<int>[]> queued(new std::atomic<int>[_n]);
+        for (int v : rest) queued[v].store(-1, std::memory_order_relaxed);
+        long long work = 0;
+        for (int round = 0; !cur.empty(); round++) {
+            work += (long long)cur.size();
+            if (work > 16LL * (long long)rest.size()) return false;
+            cur = expand(cur, threads, [&](int v, auto push) {
+                int c = color[v].load(std::memory_order_relaxed);
+                for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+                    int w = g.elist[i];
+                    if (comp[w].load(std::memory_order_relaxed) != -1) continue;
+                    int old = color[w].load(std::memory_order_relaxed);
+                    bool updated = false;
+                    while (old < c) {
+                        if (color[w].compare_exchange_weak(old, c, std::memory_order_relaxed)) {
+                            updated = true;
+                            break;
+                        }
+                    }
+                    if (updated && queued[w].exchange(round, std::memory_order_relaxed) != round) push(w);
+                }
+            });
+        }
+
+        cur.clear();
+        for (int v : rest) {
+            if (color[v].load(std::memory_order_relaxed) == v) {
+                comp[v].store(v, std::memory_order_relaxed);
+                cur.push_back(v);
+            }
+        }
+        while (!cur.empty()) {
+            cur = expand(cur, threads, [&](int v, auto push) {
+                int c = color[v].load(std::memory_order_relaxed);
+                for (int i = rg.start[v]; i < rg.start[v + 1]; i++) {
+                    int u = rg.elist[i];
+                    if (color[u].load(std::memory_order_relaxed) != c) continue;
+                    int expected = -1;
+                    if (comp[u].compare_exchange_strong(expected, c, std::memory_order_relaxed)) push(u);
+                }
+            });
+        }
+        return true;
+    }
+
+    // lists the components in a topological order of the condensation (Kahn's algorithm)
+    std::vector<std::vector<int>> topological_groups(const graph& g, const std::atomic<int>* comp) const {
+        // ids in the order of the smallest vertices
+        std::vector<int> ids(_n, -1);
+        int k = 0;
+        for (int v = 0; v < _n; v++) {
+            int r = comp[v].load(std::memory_order_relaxed);
+            if (ids[r] == -1) ids[r] = k++;
+            ids[v] = ids[r];
+        }
+        std::vector<int> indeg(k);
+        for (int v = 0; v < _n; v++) {
+            for (int i = g.start[v]; i < g.start[v + 1]; i++) indeg[ids[g.elist[i]]] += ids[g.elist[i]] != ids[v];
+        }
+        std::vector<int> members_start(k + 1), members(_n);
+        for (int v = 0; v < _n; v++) members_start[ids[v] + 1]++;
+        for (int i = 0; i < k; i++) members_start[i + 1] += members_start[i];
+        {
+            auto counter = members_start;
+            for (int v = 0; v < _n; v++) members[counter[ids[v]]++] = v;
+        }
+
+        std::vector<int> order;
+        order.reserve(k);
+        for (int i = 0; i < k; i++) {
+            if (indeg[i] == 0) order.push_back(i);
+        }
+        for (int head = 0; head < int(order.size()); head++) {
+            int c = order[head];
+            for (int j = members_start[c]; j < members_start[c + 1]; j++) {
+                int v = members[j];
+                for (int i = g.start[v]; i < g.start[v + 1]; i++) {
+                    int d = ids[g.elist[i]];
+                    if (d != c && --indeg[d] == 0) order.push_back(d);
+                }
+            }
+        }
+        assert(int(order.size()) == k);
+
+        std::vector<std::vector<int>> groups(k);
+        for (int i = 0; i < k; i++) {
+            int c = order[i];
+            groups[i] = std::vector<int>(members.begin() + members_start[c], members.begin() + members_start[c + 1]);
+        }
+        return groups;
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_PARALLEL_SCC_HPP
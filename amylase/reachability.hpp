@@ -0,0 +1,102 @@
+#ifndef AMYLASE_REACHABILITY_HPP
+#define AMYLASE_REACHABILITY_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+#include <atcoder/scc>
+
+namespace amylase {
+
+// Transitive closure of a directed graph, as a bitset of 64-bit words per strongly connected component.
+// The rows are built in the reverse topological order: a row is the union of the rows of the successors,
+// which have larger indices, so the words below them are skipped.
+// Build: O(k (k + m) / 64) time and k^2 / 8 bytes for k components and m edges in the condensation.
+// reachable: O(1).
+struct reachability_index {
+  public:
+    reachability_index() : k(0), words(0) {}
+    reachability_index(atcoder::scc_graph& g) : reachability_index(g.condensation()) {}
+    reachability_index(const atcoder::scc_graph::condensation_graph& g)
+        : ids(g.ids), k(int(g.start.size()) - 1), words((k + 63) / 64), bits((long long)k * words) {
+        for (int c = k - 1; c >= 0; c--) {
+            unsigned long long* row = bits.data() + (long long)c * words;
+            row[c >> 6] |= 1ULL << (c & 63);
+            for (int i = g.start[c]; i < g.start[c + 1]; i++) {
+                int d = g.elist[i];
+                const unsigned long long* from = bits.data() + (long long)d * words;
+                for (int w = d >> 6; w < words; w++) row[w] |= from[w];
+            }
+        }
+    }
+
+    // whether there is a path from u to v (u itself is reachable from u)
+    bool reachable(int u, int v) const {
+        assert(0 <= u && u < int(ids.size()));
+        assert(0 <= v && v < int(ids.size()));
+        int a = ids[u], b = ids[v];
+        if (a > b) return false;
+        return bits[(long long)a * words + (b >> 6)] >> (b & 63) & 1;
+    }
+
+  private:
+    std::vector<int> ids;
+    int k, words;
+    std::vector<unsigned long long> bits;
+};
+
+// Answers reachable(u, v) for the queries at once, with the columns of the transitive closure
+// split into blocks of 64 * block_words components, so that the memory is O(k * block_words) words.
+inline std::vector<bool> offline_reachability(const atcoder::scc_graph::condensation_graph& g,
+                                              const std::vector<std::pair<int, int>>& queries,
+                                              int block_words = 1 << 10) {
+    assert(block_words >= 1);
+    int n = int(g.ids.size()), k = int(g.start.size()) - 1;
+    std::vector<bool> result(queries.size());
+    // queries by the block of the head
+    int block = 64 * block_words;
+    int blocks = (k + block - 1) / block;
+    std::vector<int> count(blocks + 1);
+    for (auto q : queries) {
+        assert(0 <= q.first && q.first < n);
+        assert(0 <= q.second && q.second < n);
+        count[g.ids[q.second] / block + 1]++;
+    }
+    for (int i = 0; i < blocks; i++) count[i + 1] += count[i];
+    std::vector<int> order(queries.size());
+    {
+        auto counter = count;
+        for (int i = 0; i < int(queries.size()); i++) order[counter[g.ids[queries[i].second] / block]++] = i;
+    }
+
+    std::vector<unsigned long long> bits;
+    for (int b = 0; b < blocks; b++) {
+        if (count[b] == count[b + 1]) continue;
+        int lo = b * block, hi = std::min(k, lo + block);
+        int words = (hi - lo + 63) / 64;
+        bits.assign((long long)hi * words, 0);
+        // the components after hi cannot reach the block
+        for (int c = hi - 1; c >= 0; c--) {
+            unsigned long long* row = bits.data() + (long long)c * words;
+            if (c >= lo) row[(c - lo) >> 6] |= 1ULL << ((c - lo) & 63);
+            for (int i = g.start[c]; i < g.start[c + 1]; i++) {
+                int d = g.elist[i];
+                if (d >= hi) break;
+                const unsigned long long* from = bits.data() + (long long)d * words;
+                int w0 = d < lo ? 0 : (d - lo) >> 6;
+                for (int w = w0; w < words; w++) row[w] |= from[w];
+            }
+        }
+        for (int j = count[b]; j < count[b + 1]; j++) {
+            int i = order[j];
+            int u = g.ids[queries[i].first], v = g.ids[queries[i].second] - lo;
+            result[i] = u < hi && (bits[(long long)u * words + (v >> 6)] >> (v & 63) & 1);
+        }
+    }
+    return result;
+}
+
+}  // namespace amylase
+
+#endif  // AMYLASE_REACHABILITY_HPP
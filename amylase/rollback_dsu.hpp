@@ -0,0 +1,191 @@
+#ifndef AMYLASE_ROLLBACK_DSU_HPP
+#define AMYLASE_ROLLBACK_DSU_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace amylase {
+
+// Disjoint set union which can undo merges in LIFO order.
+// Implement (union by size) without path compression, so leader is O(log n) worst case.
+struct rollback_dsu {
+  public:
+    rollback_dsu() : _n(0), _components(0) {}
+    rollback_dsu(int n) : _n(n), _components(n), parent_or_size(n, -1) {}
+
+    int merge(int a, int b) {
+        assert(0 <= a && a < _n);
+        assert(0 <= b && b < _n);
+        int x = leader(a), y = leader(b);
+        if (x == y) {
+            history.push_back({-1, 0});
+            return x;
+        }
+        if (-parent_or_size[x] < -parent_or_size[y]) std::swap(x, y);
+        history.push_back({y, parent_or_size[y]});
+        parent_or_size[x] += parent_or_size[y];
+        parent_or_size[y] = x;
+        _components--;
+        return x;
+    }
+
+    bool same(int a, int b) const {
+        assert(0 <= a && a < _n);
+        assert(0 <= b && b < _n);
+        return leader(a) == leader(b);
+    }
+
+    int leader(int a) const {
+        assert(0 <= a && a < _n);
+        while (parent_or_size[a] >= 0) a = parent_or_size[a];
+        return a;
+    }
+
+    int size(int a) const {
+        assert(0 <= a && a < _n);
+        return -parent_or_size[leader(a)];
+    }
+
+    // number of the groups
+    int components() const { return _components; }
+
+    // @return the number of merges called so far, to be passed to rollback
+    int snapshot() const { return int(history.size()); }
+
+    // undo the last call of merge (including the ones which did not change anything)
+    void undo() {
+        assert(!history.empty());
+        int y = history.back().first;
+        if (y != -1) {
+            int x = parent_or_size[y];
+            parent_or_size[y] = history.back().second;
+            parent_or_size[x] -= parent_or_size[y];
+            _components++;
+        }
+        history.pop_back();
+    }
+
+    // undo the merges called after snapshot() returned state
+    void rollback(int state) {
+        assert(0 <= state && state <= int(history.size()));
+        while (int(history.size()) > state) undo();
+    }
+
+  private:
+    int _n, _components;
+    // root node: -1 * component size
+    // otherwise: parent
+    std::vector<int> parent_or_size;
+    // (merged root or -1, its parent_or_size before the merge)
+    std::vector<std::pair<int, int>> history;
+};
+
+// Offline connectivity queries on a graph with edge insertions and deletions.
+// Each edge is alive over an interval of the queries, which is put on O(log Q) nodes of a
+// segment tree over the queries; a DFS over it merges on the way down and rolls back on the way up.
+// solve: O((Q + E) log Q log n), where E is the number of add_edge.
+struct offline_dynamic_connectivity {
+  public:
+    offline_dynamic_connectivity() : _n(0) {}
+    offline_dynamic_connectivity(int n) : _n(n) {}
+
+    void add_edge(int u, int v) {
+        assert(0 <= u && u < _n);
+        assert(0 <= v && v < _n);
+        if (u > v) std::swap(u, v);
+        alive[{u, v}].push_back(int(edges.size()));
+        edges.push_back({u, v, int(queries.size()), -1});
+    }
+
+    // removes one of the edges (u, v) added before
+    void remove_edge(int u, int v) {
+        assert(0 <= u && u < _n);
+        assert(0 <= v && v < _n);
+        if (u > v) std::swap(u, v);
+        auto it = alive.find({u, v});
+        assert(it != alive.end());
+        edges[it->second.back()].end = int(queries.size());
+        it->second.pop_back();
+        if (it->second.empty()) alive.erase(it);
+    }
+
+    // @return the index of the query "are u and v connected now?"
+    int add_query(int u, int v) {
+        assert(0 <= u && u < _n);
+        assert(0 <= v && v < _n);
+        queries.push_back({u, v});
+        return int(queries.size()) - 1;
+    }
+
+    std::vector<bool> solve() {
+        std::vector<bool> result(queries.size());
+        solve([&](int i, const rollback_dsu& uf) {
+            result[i] = uf.same(queries[i].first, queries[i].second);
+        });
+        return result;
+    }
+
+    // calls f(i, uf) for each query i in increasing order, where uf is connected by the edges
+    // alive at the query
+    template <class F> void solve(F f) {
+        int q = int(queries.size());
+        if (q == 0) return;
+        size = 1;
+        while (size < q) size <<= 1;
+
+        // edges on each node, in CSR
+        start.assign(2 * size + 1, 0);
+        auto for_each_node = [&](const edge& e, auto g) {
+            int end = e.end == -1 ? q : e.end;
+            for (int l = e.begin + size, r = end + size; l < r; l >>= 1, r >>= 1) {
+                if (l & 1) g(l++);
+                if (r & 1) g(--r);
+            }
+        };
+        for (auto& e : edges) for_each_node(e, [&](int k) { start[k + 1]++; });
+        for (int k = 0; k < 2 * size; k++) start[k + 1] += start[k];
+        elist.resize(start[2 * size]);
+        {
+            std::vector<int> counter(start.begin(), start.end() - 1);
+            for (int i = 0; i < int(edges.size()); i++) {
+                for_each_node(edges[i], [&](int k) { elist[counter[k]++] = i; });
+            }
+        }
+
+        rollback_dsu uf(_n);
+        dfs(1, 0, size, q, uf, f);
+    }
+
+  private:
+    struct edge {
+        int u, v, begin, end;  // alive for the queries [begin, end), end = -1 if never removed
+    };
+
+    int _n, size;
+    std::vector<edge> edges;
+    std::vector<std::pair<int, int>> queries;
+    std::map<std::pair<int, int>, std::vector<int>> alive;
+    std::vector<int> start, elist;
+
+    // node k covers the queries [l, r). The depth of the recursion is O(log Q).
+    template <class F> void dfs(int k, int l, int r, int q, rollback_dsu& uf, F& f) {
+        if (q <= l) return;
+        int state = uf.snapshot();
+        for (int i = start[k]; i < start[k + 1]; i++) uf.merge(edges[elist[i]].u, edges[elist[i]].v);
+        if (r - l == 1) {
+            f(l, static_cast<const rollback_dsu&>(uf));
+        } else {
+            int mid = (l + r) / 2;
+            dfs(2 * k, l, mid, q, uf, f);
+            dfs(2 * k + 1, mid, r, q, uf, f);
+        }
+        uf.rollback(state);
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_ROLLBACK_DSU_HPP
@@ -2,9 +2,14 @@
 #define AMYLASE_SEGTREES_HPP 1
 
 #include <algorithm>
+#include <cassert>
 #include <limits>
+#include <vector>
 #include <atcoder/segtree>
 #include <atcoder/lazysegtree>
+#include <amylase/segtree_beats>
+#include <amylase/compact_lazy_segtree>
+#include <amylase/sparse_table>
 
 namespace amylase {
 
@@ -19,18 +24,223 @@ namespace amylase {
     template<class T> using max_segtree = atcoder::segtree<T, max<T>, std::numeric_limits<T>::lowest>;
     template<class T> using sum_segtree = atcoder::segtree<T, add<T>, zero<T>>;
 
+    // static tables: `prod`_sparse_table, O(1) per query
+    template<class T> using min_sparse_table = sparse_table<T, min<T>, std::numeric_limits<T>::max>;
+    template<class T> using max_sparse_table = sparse_table<T, max<T>, std::numeric_limits<T>::lowest>;
+    template<class T> using sum_sparse_table = disjoint_sparse_table<T, add<T>, zero<T>>;
+
     // lazy segtrees: `prod`_`func`_segtree
-    template<class T> using min_min_segtree = atcoder::lazy_segtree<T, min<T>, std::numeric_limits<T>::max, T, min<T>, min<T>, std::numeric_limits<T>::max>;
-    template<class T> using min_sum_segtree = atcoder::lazy_segtree<T, min<T>, std::numeric_limits<T>::max, T, add<T>, add<T>, zero<T>>;
-    template<class T> using max_max_segtree = atcoder::lazy_segtree<T, max<T>, std::numeric_limits<T>::lowest, T, max<T>, max<T>, std::numeric_limits<T>::lowest>;
-    template<class T> using max_sum_segtree = atcoder::lazy_segtree<T, max<T>, std::numeric_limits<T>::lowest, T, add<T>, add<T>, zero<T>>;
-    template<class T> using sum_sum_segtree = atcoder::lazy_segtree<T, add<T>, zero<T>, T, add<T>, add<T>, zero<T>>;
+    // `compact = true` uses compact_lazy_segtree: about half the memory when n is not a power of two.
+    template<class T, bool compact = false> using min_min_segtree = lazy_segtree_layout<T, min<T>, std::numeric_limits<T>::max, T, min<T>, min<T>, std::numeric_limits<T>::max, compact>;
+    template<class T, bool compact = false> using min_sum_segtree = lazy_segtree_layout<T, min<T>, std::numeric_limits<T>::max, T, add<T>, add<T>, zero<T>, compact>;
+    template<class T, bool compact = false> using max_max_segtree = lazy_segtree_layout<T, max<T>, std::numeric_limits<T>::lowest, T, max<T>, max<T>, std::numeric_limits<T>::lowest, compact>;
+    template<class T, bool compact = false> using max_sum_segtree = lazy_segtree_layout<T, max<T>, std::numeric_limits<T>::lowest, T, add<T>, add<T>, zero<T>, compact>;
+    template<class T, bool compact = false> using sum_sum_segtree = lazy_segtree_layout<T, add<T>, zero<T>, T, add<T>, add<T>, zero<T>, compact>;
+
+    // range assign: `prod`_assign_segtree. F is `assign_action<T>::of(x)`.
+    template<class T> struct assign_action {
+        T value;
+        bool assigned;
+
+        static assign_action of(T x) { return {x, true}; }
+    };
+    template<class T> T assign_mapping(const assign_action<T> f, const T x) { return f.assigned ? f.value : x; }
+    template<class T> assign_action<T> assign_composition(const assign_action<T> f, const assign_action<T> g) { return f.assigned ? f : g; }
+    template<class T> assign_action<T> assign_id() { return {T(), false}; }
+
+    template<class T, bool compact = false> using min_assign_segtree = lazy_segtree_layout<T, min<T>, std::numeric_limits<T>::max, assign_action<T>, assign_mapping<T>, assign_composition<T>, assign_id<T>, compact>;
+    template<class T, bool compact = false> using max_assign_segtree = lazy_segtree_layout<T, max<T>, std::numeric_limits<T>::lowest, assign_action<T>, assign_mapping<T>, assign_composition<T>, assign_id<T>, compact>;
+
+    // range sum needs the length of the range. Build with `sum_nodes(v)`.
+    template<class T> struct sum_node {
+        T sum;
+        int size;
+
+        sum_node() : sum(0), size(0) {}
+        sum_node(T x) : sum(x), size(1) {}
+        sum_node(T _sum, int _size) : sum(_sum), size(_size) {}
+    };
+    template<class T> sum_node<T> sum_op(const sum_node<T> a, const sum_node<T> b) { return {a.sum + b.sum, a.size + b.size}; }
+    template<class T> sum_node<T> sum_e() { return sum_node<T>(); }
+    template<class T> std::vector<sum_node<T>> sum_nodes(const std::vector<T>& v) {
+        return std::vector<sum_node<T>>(v.begin(), v.end());
+    }
+
+    template<class T> sum_node<T> sum_assign_mapping(const assign_action<T> f, const sum_node<T> x) {
+        return f.assigned ? sum_node<T>(f.value * x.size, x.size) : x;
+    }
+    template<class T, bool compact = false> using sum_assign_segtree = lazy_segtree_layout<sum_node<T>, sum_op<T>, sum_e<T>, assign_action<T>, sum_assign_mapping<T>, assign_composition<T>, assign_id<T>, compact>;
+
+    // range affine: x -> a * x + b. Typically T is a modint.
+    template<class T> struct affine_action {
+        T a, b;
+    };
+    template<class T> sum_node<T> sum_affine_mapping(const affine_action<T> f, const sum_node<T> x) {
+        return {f.a * x.sum + f.b * x.size, x.size};
+    }
+    // f . g
+    template<class T> affine_action<T> affine_composition(const affine_action<T> f, const affine_action<T> g) {
+        return {f.a * g.a, f.a * g.b + f.b};
+    }
+    template<class T> affine_action<T> affine_id() { return {1, 0}; }
+    template<class T, bool compact = false> using sum_affine_segtree = lazy_segtree_layout<sum_node<T>, sum_op<T>, sum_e<T>, affine_action<T>, sum_affine_mapping<T>, affine_composition<T>, affine_id<T>, compact>;
+
+    // segtree beats: range chmin / chmax / add, range sum / max / min.
+    // Each update is amortized O(log^2 n).
+    template<class T> struct beats_node {
+        T sum, max1, max2, min1, min2;  // max2 (min2) is the strict second max (min)
+        int max_cnt, min_cnt, size;
+        bool fail;
+
+        beats_node() : sum(0), max1(lowest()), max2(lowest()), min1(highest()), min2(highest()),
+                       max_cnt(0), min_cnt(0), size(0), fail(false) {}
+        beats_node(T x) : sum(x), max1(x), max2(lowest()), min1(x), min2(highest()),
+                          max_cnt(1), min_cnt(1), size(1), fail(false) {}
+
+        static T lowest() { return std::numeric_limits<T>::lowest(); }
+        static T highest() { return std::numeric_limits<T>::max(); }
+    };
+
+    // x -> min(max(x + add, lower), upper)
+    template<class T> struct beats_action {
+        T lower, upper, add;
+
+        static beats_action chmin(T x) { return {beats_node<T>::lowest(), x, 0}; }
+        static beats_action chmax(T x) { return {x, beats_node<T>::highest(), 0}; }
+        static beats_action plus(T x) { return {beats_node<T>::lowest(), beats_node<T>::highest(), x}; }
+    };
+
+    template<class T> T beats_shift(const T x, const T a) {
+        return (x == beats_node<T>::lowest() || x == beats_node<T>::highest()) ? x : x + a;
+    }
+
+    template<class T> beats_node<T> beats_op(const beats_node<T> a, const beats_node<T> b) {
+        beats_node<T> c;
+        c.sum = a.sum + b.sum;
+        c.size = a.size + b.size;
+        if (a.max1 > b.max1) {
+            c.max1 = a.max1, c.max_cnt = a.max_cnt, c.max2 = std::max(a.max2, b.max1);
+        } else if (a.max1 < b.max1) {
+            c.max1 = b.max1, c.max_cnt = b.max_cnt, c.max2 = std::max(a.max1, b.max2);
+        } else {
+            c.max1 = a.max1, c.max_cnt = a.max_cnt + b.max_cnt, c.max2 = std::max(a.max2, b.max2);
+        }
+        if (a.min1 < b.min1) {
+            c.min1 = a.min1, c.min_cnt = a.min_cnt, c.min2 = std::min(a.min2, b.min1);
+        } else if (a.min1 > b.min1) {
+            c.min1 = b.min1, c.min_cnt = b.min_cnt, c.min2 = std::min(a.min1, b.min2);
+        } else {
+            c.min1 = a.min1, c.min_cnt = a.min_cnt + b.min_cnt, c.min2 = std::min(a.min2, b.min2);
+        }
+        return c;
+    }
+    template<class T> beats_node<T> beats_e() { return beats_node<T>(); }
+
+    template<class T> beats_node<T> beats_mapping(const beats_action<T> f, beats_node<T> x) {
+        if (x.size == 0) return x;
+        if (f.add != 0) {
+            x.sum += f.add * x.size;
+            x.max1 += f.add, x.min1 += f.add;
+            x.max2 = beats_shift(x.max2, f.add), x.min2 = beats_shift(x.min2, f.add);
+        }
+        if (f.lower > x.min1) {
+            if (f.lower >= x.min2) {
+                x.fail = true;
+                return x;
+            }
+            // only the minimums are raised
+            x.sum += (f.lower - x.min1) * x.min_cnt;
+            if (x.max1 == x.min1) x.max1 = f.lower;
+            else if (x.max2 == x.min1) x.max2 = f.lower;
+            x.min1 = f.lower;
+        }
+        if (f.upper < x.max1) {
+            if (f.upper <= x.max2) {
+                x.fail = true;
+                return x;
+            }
+            // only the maximums are lowered
+            x.sum -= (x.max1 - f.upper) * x.max_cnt;
+            if (x.min1 == x.max1) x.min1 = f.upper;
+            else if (x.min2 == x.max1) x.min2 = f.upper;
+            x.max1 = f.upper;
+        }
+        return x;
+    }
+
+    // f . g
+    template<class T> beats_action<T> beats_composition(const beats_action<T> f, const beats_action<T> g) {
+        beats_action<T> h;
+        h.add = g.add + f.add;
+        h.lower = std::min(std::max(beats_shift(g.lower, f.add), f.lower), f.upper);
+        h.upper = std::min(std::max(beats_shift(g.upper, f.add), f.lower), f.upper);
+        return h;
+    }
+    template<class T> beats_action<T> beats_id() { return beats_action<T>::plus(0); }
+
+    template<class T> std::vector<beats_node<T>> beats_nodes(const std::vector<T>& v) {
+        return std::vector<beats_node<T>>(v.begin(), v.end());
+    }
+
+    // use `beats_action<T>::chmin(x)`, `chmax(x)` and `plus(x)` as `F`, and `beats_nodes(v)` to build.
+    template<class T> using sum_beats_segtree = segtree_beats<beats_node<T>, beats_op<T>, beats_e<T>, beats_action<T>, beats_mapping<T>, beats_composition<T>, beats_id<T>>;
 
     // NOTE: `sum_max_segtree` and `sum_min_segtree` is not available because straightforward approach does not work.
-    // You can implement these operations if the array is monotone (not necessarily strict). Sketch is as follows.
-    // Mapper is `overwrite`. You can determine which element should be overwritten when range-max is queried (Monotonicity is exploited here).
-    // Each element manages range_sum, range_max, size. Composition and Production are obvious by definitions.
-    // Example: https://codeforces.com/problemset/submission/1439/98821386
+    // Use `sum_beats_segtree` instead, which supports range chmax / chmin in amortized O(log^2 n).
+    // If the array is monotone (not necessarily strict), use `monotone_sum_max_segtree` or `monotone_sum_min_segtree`,
+    // which run in O(log n). Mapper is `overwrite`: the elements to be overwritten form a prefix (chmax) or
+    // a suffix (chmin) of the range, and the boundary is found by binary search on the tree.
+    template<class T> struct monotone_node {
+        T sum, min, max;
+        int size;
+    };
+    template<class T> monotone_node<T> monotone_op(const monotone_node<T> a, const monotone_node<T> b) {
+        if (a.size == 0) return b;
+        if (b.size == 0) return a;
+        return {a.sum + b.sum, a.min, b.max, a.size + b.size};
+    }
+    template<class T> monotone_node<T> monotone_e() { return {0, 0, 0, 0}; }
+    template<class T> monotone_node<T> monotone_mapping(const assign_action<T> f, const monotone_node<T> x) {
+        return f.assigned ? monotone_node<T>{f.value * x.size, f.value, f.value, x.size} : x;
+    }
+
+    // apply(l, r, x) replaces a[i] with max(a[i], x) (is_max) or min(a[i], x) for i in [l, r).
+    // The array must be non-decreasing, and stay so after each apply (e.g. chmax on a suffix, chmin on a prefix).
+    template<class T, bool is_max> struct monotone_sum_segtree {
+      public:
+        monotone_sum_segtree() : monotone_sum_segtree(0) {}
+        monotone_sum_segtree(int n) : monotone_sum_segtree(std::vector<T>(n, 0)) {}
+        monotone_sum_segtree(const std::vector<T>& v) : _n(int(v.size())) {
+            assert(std::is_sorted(v.begin(), v.end()));
+            std::vector<monotone_node<T>> nodes(_n);
+            for (int i = 0; i < _n; i++) nodes[i] = {v[i], v[i], v[i], 1};
+            seg = tree(nodes);
+        }
+
+        T get(int p) { return seg.get(p).sum; }
+        T prod(int l, int r) { return seg.prod(l, r).sum; }
+        T all_prod() { return seg.all_prod().sum; }
+
+        void apply(int l, int r, T x) {
+            assert(0 <= l && l <= r && r <= _n);
+            if (is_max) {
+                // a[l, m) < x <= a[m, r)
+                int m = seg.max_right(l, [&](const monotone_node<T>& s) { return s.size == 0 || s.max < x; });
+                seg.apply(l, std::min(m, r), assign_action<T>::of(x));
+            } else {
+                // a[l, m) <= x < a[m, r)
+                int m = seg.min_left(r, [&](const monotone_node<T>& s) { return s.size == 0 || x < s.min; });
+                seg.apply(std::max(m, l), r, assign_action<T>::of(x));
+            }
+        }
+
+      private:
+        using tree = atcoder::lazy_segtree<monotone_node<T>, monotone_op<T>, monotone_e<T>, assign_action<T>, monotone_mapping<T>, assign_composition<T>, assign_id<T>>;
+        int _n;
+        tree seg;
+    };
+    template<class T> using monotone_sum_max_segtree = monotone_sum_segtree<T, true>;
+    template<class T> using monotone_sum_min_segtree = monotone_sum_segtree<T, false>;
 
 }  // namespace amylase
 
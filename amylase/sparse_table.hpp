@@ -0,0 +1,174 @@
+#ifndef AMYLASE_SPARSE_TABLE_HPP
+#define AMYLASE_SPARSE_TABLE_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include <atcoder/internal_bit>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace amylase {
+
+namespace internal {
+
+// @param n `1 <= n`
+// @return maximum `x` s.t. `2**x <= n`
+inline int floor_log2(unsigned int n) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, n);
+    return index;
+#else
+    return 31 - __builtin_clz(n);
+#endif
+}
+
+}  // namespace internal
+
+// Static range product in O(1) for an idempotent op (op(x, x) = x), e.g. min, max, gcd.
+// O(n log n) time and memory to build.
+template <class S, S (*op)(S, S), S (*e)()> struct sparse_table {
+  public:
+    sparse_table() : sparse_table(std::vector<S>()) {}
+    sparse_table(const std::vector<S>& v) : _n(int(v.size())) {
+        table.push_back(v);
+        for (int k = 1; (1 << k) <= _n; k++) {
+            const std::vector<S>& prev = table.back();
+            std::vector<S> cur(_n - (1 << k) + 1);
+            for (int i = 0; i < int(cur.size()); i++) {
+                cur[i] = op(prev[i], prev[i + (1 << (k - 1))]);
+            }
+            table.push_back(std::move(cur));
+        }
+    }
+
+    S get(int p) const {
+        assert(0 <= p && p < _n);
+        return table[0][p];
+    }
+
+    S prod(int l, int r) const {
+        assert(0 <= l && l <= r && r <= _n);
+        if (l == r) return e();
+        int k = internal::floor_log2(r - l);
+        return op(table[k][l], table[k][r - (1 << k)]);
+    }
+
+  private:
+    int _n;
+    // table[k][i]: op over [i, i + 2**k)
+    std::vector<std::vector<S>> table;
+};
+
+// Static range product in O(1) for any associative op.
+// O(n log n) time and memory to build.
+template <class S, S (*op)(S, S), S (*e)()> struct disjoint_sparse_table {
+  public:
+    disjoint_sparse_table() : disjoint_sparse_table(std::vector<S>()) {}
+    disjoint_sparse_table(const std::vector<S>& v) : _n(int(v.size())), leaf(v) {
+        log = 0;
+        while ((1 << log) < _n) log++;
+        table = std::vector<std::vector<S>>(log, std::vector<S>(_n));
+        for (int k = 0; k < log; k++) {
+            // blocks of size 2**(k+1), split at their middle
+            for (int mid = 1 << k; mid < _n; mid += 1 << (k + 1)) {
+                int start = mid - (1 << k), end = std::min(mid + (1 << k), _n);
+                table[k][mid - 1] = v[mid - 1];
+                for (int i = mid - 2; i >= start; i--) table[k][i] = op(v[i], table[k][i + 1]);
+                table[k][mid] = v[mid];
+                for (int i = mid + 1; i < end; i++) table[k][i] = op(table[k][i - 1], v[i]);
+            }
+        }
+    }
+
+    S get(int p) const {
+        assert(0 <= p && p < _n);
+        return leaf[p];
+    }
+
+    S prod(int l, int r) const {
+        assert(0 <= l && l <= r && r <= _n);
+        if (l == r) return e();
+        r--;
+        if (l == r) return leaf[l];
+        int k = internal::floor_log2(l ^ r);
+        return op(table[k][l], table[k][r]);
+    }
+
+  private:
+    int _n, log;
+    std::vector<S> leaf;
+    // table[k][i]: op over [i, mid) if i < mid, otherwise op over [mid, i],
+    // where mid is the middle of the block of size 2**(k+1) containing i.
+    std::vector<std::vector<S>> table;
+};
+
+// sparse_table with O(n) memory for very large arrays.
+// op must select one of its arguments (op(x, y) is x or y, e.g. min or max), and S must support ==.
+// The array is cut into blocks of 32 elements, and a sparse table is built over the block products.
+// Inside a block, the mask of i is the monotone stack of the block after pushing i, as a bitmask
+// of offsets: the product of [l, i] in the block is at the lowest offset in the mask that is >= l.
+// Each element is stored next to its mask, so that prod touches few cache lines.
+// n (S, 32-bit mask) pairs and (n / 32) log(n / 32) S in total. prod is O(1).
+template <class S, S (*op)(S, S), S (*e)()> struct block_sparse_table {
+  public:
+    block_sparse_table() : block_sparse_table(std::vector<S>()) {}
+    block_sparse_table(const std::vector<S>& v) : _n(int(v.size())), d(_n) {
+        for (int i = 0; i < _n; i++) d[i].x = v[i];
+        int nb = (_n + B - 1) / B;
+        std::vector<S> blocks(nb);
+        for (int b = 0; b < nb; b++) {
+            int start = b * B, end = std::min(start + B, _n);
+            unsigned int stack = 0;
+            for (int i = start; i < end; i++) {
+                // pop the elements which d[i] wins against
+                while (stack && op(d[i].x, d[start + internal::floor_log2(stack)].x) == d[i].x) {
+                    stack ^= 1u << internal::floor_log2(stack);
+                }
+                stack |= 1u << (i - start);
+                d[i].mask = stack;
+            }
+            blocks[b] = in_block(start, end - 1);
+        }
+        table = sparse_table<S, op, e>(blocks);
+    }
+
+    S get(int p) const {
+        assert(0 <= p && p < _n);
+        return d[p].x;
+    }
+
+    S prod(int l, int r) const {
+        assert(0 <= l && l <= r && r <= _n);
+        if (l == r) return e();
+        r--;
+        int bl = l / B, br = r / B;
+        if (bl == br) return in_block(l, r);
+        S sm = op(in_block(l, bl * B + B - 1), in_block(br * B, r));
+        if (bl + 1 < br) sm = op(sm, table.prod(bl + 1, br));
+        return sm;
+    }
+
+  private:
+    static constexpr int B = 32;
+    int _n;
+    struct element {
+        S x;
+        unsigned int mask;
+    };
+    std::vector<element> d;
+    sparse_table<S, op, e> table;
+
+    // the product of [l, r] in one block
+    S in_block(int l, int r) const {
+        int start = l / B * B;
+        return d[start + atcoder::internal::bsf(d[r].mask >> (l - start) << (l - start))].x;
+    }
+};
+
+}  // namespace amylase
+
+#endif  // AMYLASE_SPARSE_TABLE_HPP
@@ -0,0 +1,115 @@
+#ifndef AMYLASE_WEIGHTED_DSU_HPP
+#define AMYLASE_WEIGHTED_DSU_HPP 1
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace amylase {
+
+// Disjoint set union which keeps the differences of the potentials x_v within each group,
+// for an abelian group (S, op, e) with the inverse inv. The differences are written in additive notation.
+// Implement (union by size) + (path compression), with no recursion
+template <class S, S (*op)(S, S), S (*e)(), S (*inv)(S)> struct weighted_dsu {
+  public:
+    weighted_dsu() : _n(0) {}
+    weighted_dsu(int n) : _n(n), parent_or_size(n, -1), weight(n, e()) {}
+
+    // add the constraint x_b - x_a = w
+    // @return false if it contradicts the previous ones (then nothing is changed)
+    bool merge(int a, int b, S w) {
+        assert(0 <= a && a < _n);
+        assert(0 <= b && b < _n);
+        int x = leader(a), y = leader(b);
+        // x_y - x_x = w + (x_a - x_x) - (x_b - x_y)
+        S d = op(op(w, weight[a]), inv(weight[b]));
+        if (x == y) return d == e();
+        if (-parent_or_size[x] < -parent_or_size[y]) {
+            std::swap(x, y);
+            d = inv(d);
+        }
+        parent_or_size[x] += parent_or_size[y];
+        parent_or_size[y] = x;
+        weight[y] = d;
+        return true;
+    }
+
+    bool same(int a, int b) {
+        assert(0 <= a && a < _n);
+        assert(0 <= b && b < _n);
+        return leader(a) == leader(b);
+    }
+
+    // x_b - x_a for a and b in the same group
+    S diff(int a, int b) {
+        // leader makes the weights relative to the leader, so it runs outside of assert
+        leader(a);
+        leader(b);
+        assert(same(a, b));
+        return op(weight[b], inv(weight[a]));
+    }
+
+    // x_a - x_(leader(a))
+    S potential(int a) {
+        leader(a);
+        return weight[a];
+    }
+
+    int leader(int a) {
+        assert(0 <= a && a < _n);
+        int r = a;
+        S sum = e();
+        while (parent_or_size[r] >= 0) {
+            sum = op(sum, weight[r]);
+            r = parent_or_size[r];
+        }
+        // sum is the potential of a relative to r. Walking up, subtract the old weight
+        // of each node to get the one of its parent.
+        while (a != r) {
+            int p = parent_or_size[a];
+            S w = weight[a];
+            parent_or_size[a] = r;
+            weight[a] = sum;
+            sum = op(sum, inv(w));
+            a = p;
+        }
+        return r;
+    }
+
+    int size(int a) {
+        assert(0 <= a && a < _n);
+        return -parent_or_size[leader(a)];
+    }
+
+  private:
+    int _n;
+    // root node: -1 * component size
+    // otherwise: parent
+    std::vector<int> parent_or_size;
+    // x_v - x_parent, e() for the roots
+    std::vector<S> weight;
+};
+
+namespace internal {
+
+template <class T> T weighted_dsu_add(T x, T y) { return x + y; }
+template <class T> T weighted_dsu_zero() { return T(0); }
+template <class T> T weighted_dsu_neg(T x) { return -x; }
+template <class T> T weighted_dsu_xor(T x, T y) { return x ^ y; }
+template <class T> T weighted_dsu_self(T x) { return x; }
+
+}  // namespace internal
+
+// x_b - x_a = w over integers, modints, doubles etc.
+template <class T>
+using potential_dsu = weighted_dsu<T, internal::weighted_dsu_add<T>, internal::weighted_dsu_zero<T>,
+                                   internal::weighted_dsu_neg<T>>;
+
+// x_b xor x_a = w
+template <class T>
+using xor_dsu = weighted_dsu<T, internal::weighted_dsu_xor<T>, internal::weighted_dsu_zero<T>,
+                             internal::weighted_dsu_self<T>>;
+
+}  // namespace amylase
+
+#endif  // AMYLASE_WEIGHTED_DSU_HPP
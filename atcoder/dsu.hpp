@@ -3,11 +3,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <utility>
 #include <vector>
 
 namespace atcoder {
 
-// Implement (union by size) + (path compression)
+// Implement (union by size) + (path halving)
 // Reference:
 // Zvi Galil and Giuseppe F. Italiano,
 // Data structures and algorithms for disjoint set union problems
@@ -35,8 +36,13 @@ struct dsu {
 
     int leader(int a) {
         assert(0 <= a && a < _n);
-        if (parent_or_size[a] < 0) return a;
-        return parent_or_size[a] = leader(parent_or_size[a]);
+        // every other node on the path is linked to its grandparent, without recursion
+        while (parent_or_size[a] >= 0) {
+            int p = parent_or_size[a];
+            if (parent_or_size[p] < 0) return p;
+            a = parent_or_size[a] = parent_or_size[p];
+        }
+        return a;
     }
 
     int size(int a) {
@@ -45,23 +51,32 @@ struct dsu {
     }
 
     std::vector<std::vector<int>> groups() {
-        std::vector<int> leader_buf(_n), group_size(_n);
-        for (int i = 0; i < _n; i++) {
-            leader_buf[i] = leader(i);
-            group_size[leader_buf[i]]++;
+        auto g = groups_csr();
+        int m = int(g.first.size()) - 1;
+        std::vector<std::vector<int>> result(m);
+        for (int i = 0; i < m; i++) {
+            result[i] = std::vector<int>(g.second.begin() + g.first[i],
+                                         g.second.begin() + g.first[i + 1]);
         }
-        std::vector<std::vector<int>> result(_n);
+        return result;
+    }
+
+    // the members of the i-th group are
+    // second[first[i]], ..., second[first[i + 1] - 1]
+    std::pair<std::vector<int>, std::vector<int>> groups_csr() {
+        // group_id[v]: id of the group led by v, or -1
+        std::vector<int> start(1, 0), group_id(_n, -1);
         for (int i = 0; i < _n; i++) {
-            result[i].reserve(group_size[i]);
+            if (parent_or_size[i] < 0) {
+                group_id[i] = int(start.size()) - 1;
+                start.push_back(start.back() - parent_or_size[i]);
+            }
         }
+        std::vector<int> members(_n), counter(start.begin(), start.end() - 1);
         for (int i = 0; i < _n; i++) {
-            result[leader_buf[i]].push_back(i);
+            members[counter[group_id[leader(i)]]++] = i;
         }
-        result.erase(
-            std::remove_if(result.begin(), result.end(),
-                           [&](const std::vector<int>& v) { return v.empty(); }),
-            result.end());
-        return result;
+        return {std::move(start), std::move(members)};
     }
 
   private:
@@ -14,6 +14,13 @@ template <class T> struct fenwick_tree {
   public:
     fenwick_tree() : _n(0) {}
     fenwick_tree(int n) : _n(n), data(n) {}
+    fenwick_tree(const std::vector<T>& v) : _n(int(v.size())), data(_n) {
+        for (int i = 1; i <= _n; i++) {
+            data[i - 1] += U(v[i - 1]);
+            int j = i + (i & -i);
+            if (j <= _n) data[j - 1] += data[i - 1];
+        }
+    }
 
     void add(int p, T x) {
         assert(0 <= p && p < _n);
@@ -29,6 +36,22 @@ template <class T> struct fenwick_tree {
         return sum(r) - sum(l);
     }
 
+    // @return minimum p s.t. sum(0, p + 1) >= w, or n if there is no such p
+    // (all elements must be non-negative)
+    int lower_bound(T w) {
+        int p = 0;
+        U s = 0;
+        int k = 1;
+        while (2 * k <= _n) k *= 2;
+        for (; k > 0; k /= 2) {
+            if (p + k <= _n && T(s + data[p + k - 1]) < w) {
+                p += k;
+                s += data[p - 1];
+            }
+        }
+        return p;
+    }
+
   private:
     int _n;
     std::vector<U> data;
@@ -26,53 +26,84 @@ template <class E> struct csr {
     }
 };
 
+// DAG of the strongly connected components, in the topological order of scc()
+struct condensation_graph {
+    // ids[v]: index of the component of the vertex v
+    std::vector<int> ids;
+    // the edges from the component i go to elist[start[i]], ..., elist[start[i + 1] - 1],
+    // which are distinct, in increasing order, and greater than i
+    std::vector<int> start, elist;
+};
+
+// Strongly connected components of a graph in CSR form:
+// the edges from v go to to(start[v]), ..., to(start[v + 1] - 1)
+// @return pair of (# of scc, scc id), in topological order
+//
 // Reference:
 // R. Tarjan,
 // Depth-First Search and Linear Graph Algorithms
-struct scc_graph {
-  public:
-    scc_graph(int n) : _n(n) {}
-
-    int num_vertices() { return _n; }
-
-    void add_edge(int from, int to) { edges.push_back({from, {to}}); }
-
-    // @return pair of (# of scc, scc id)
-    std::pair<int, std::vector<int>> scc_ids() {
-        auto g = csr<edge>(_n, edges);
-        int now_ord = 0, group_num = 0;
-        std::vector<int> visited, low(_n), ord(_n, -1), ids(_n);
-        visited.reserve(_n);
-        auto dfs = [&](auto self, int v) -> void {
-            low[v] = ord[v] = now_ord++;
-            visited.push_back(v);
-            for (int i = g.start[v]; i < g.start[v + 1]; i++) {
-                auto to = g.elist[i].to;
-                if (ord[to] == -1) {
-                    self(self, to);
-                    low[v] = std::min(low[v], low[to]);
+template <class Start, class To>
+std::pair<int, std::vector<int>> scc_ids_csr(int n, const Start& start, To to) {
+    int now_ord = 0, group_num = 0;
+    std::vector<int> visited, low(n), ord(n, -1), ids(n);
+    visited.reserve(n);
+    // the DFS runs on an explicit stack of (vertex, next edge index),
+    // so that deep graphs do not overflow the call stack
+    std::vector<std::pair<int, int>> stack;
+    auto enter = [&](int v) {
+        low[v] = ord[v] = now_ord++;
+        visited.push_back(v);
+        stack.push_back({v, start[v]});
+    };
+    for (int i = 0; i < n; i++) {
+        if (ord[i] != -1) continue;
+        enter(i);
+        while (!stack.empty()) {
+            int v = stack.back().first;
+            if (stack.back().second < start[v + 1]) {
+                int u = to(stack.back().second++);
+                if (ord[u] == -1) {
+                    enter(u);
                 } else {
-                    low[v] = std::min(low[v], ord[to]);
+                    low[v] = std::min(low[v], ord[u]);
                 }
+                continue;
             }
+            stack.pop_back();
             if (low[v] == ord[v]) {
                 while (true) {
                     int u = visited.back();
                     visited.pop_back();
-                    ord[u] = _n;
+                    ord[u] = n;
                     ids[u] = group_num;
                     if (u == v) break;
                 }
                 group_num++;
             }
-        };
-        for (int i = 0; i < _n; i++) {
-            if (ord[i] == -1) dfs(dfs, i);
-        }
-        for (auto& x : ids) {
-            x = group_num - 1 - x;
+            if (!stack.empty()) {
+                int p = stack.back().first;
+                low[p] = std::min(low[p], low[v]);
+            }
         }
-        return {group_num, ids};
+    }
+    for (auto& x : ids) {
+        x = group_num - 1 - x;
+    }
+    return {group_num, ids};
+}
+
+struct scc_graph {
+  public:
+    scc_graph(int n) : _n(n) {}
+
+    int num_vertices() { return _n; }
+
+    void add_edge(int from, int to) { edges.push_back({from, {to}}); }
+
+    // @return pair of (# of scc, scc id)
+    std::pair<int, std::vector<int>> scc_ids() {
+        auto g = csr<edge>(_n, edges);
+        return scc_ids_csr(_n, g.start, [&](int i) { return g.elist[i].to; });
     }
 
     std::vector<std::vector<int>> scc() {
@@ -90,6 +121,45 @@ struct scc_graph {
         return groups;
     }
 
+    condensation_graph condensation() {
+        auto ids = scc_ids();
+        int k = ids.first;
+        condensation_graph g;
+        g.ids = std::move(ids.second);
+        // counting sort by the head, then stably by the tail, so that each list is sorted
+        std::vector<int> count(k + 1);
+        for (auto& e : edges) count[g.ids[e.second.to] + 1]++;
+        for (int i = 0; i < k; i++) count[i + 1] += count[i];
+        std::vector<std::pair<int, int>> by_head(edges.size());
+        for (auto& e : edges) {
+            int a = g.ids[e.first], b = g.ids[e.second.to];
+            by_head[count[b]++] = {a, b};
+        }
+        g.start.assign(k + 1, 0);
+        for (auto& e : by_head) g.start[e.first + 1]++;
+        for (int i = 0; i < k; i++) g.start[i + 1] += g.start[i];
+        std::vector<int> elist(edges.size()), counter(g.start.begin(), g.start.end() - 1);
+        for (auto& e : by_head) elist[counter[e.first]++] = e.second;
+        by_head.clear();
+        by_head.shrink_to_fit();
+
+        // remove the loops and the duplicates
+        int m = 0;
+        for (int i = 0; i < k; i++) {
+            int l = g.start[i], r = g.start[i + 1];
+            g.start[i] = m;
+            for (int j = l; j < r; j++) {
+                if (elist[j] == i || (j > l && elist[j] == elist[j - 1])) continue;
+                elist[m++] = elist[j];
+            }
+        }
+        g.start[k] = m;
+        elist.resize(m);
+        elist.shrink_to_fit();
+        g.elist = std::move(elist);
+        return g;
+    }
+
   private:
     int _n;
     struct edge {
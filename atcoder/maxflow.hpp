@@ -6,6 +6,7 @@
 #include <cassert>
 #include <limits>
 #include <queue>
+#include <utility>
 #include <vector>
 
 namespace atcoder {
@@ -14,11 +15,30 @@ template <class Cap> struct mf_graph {
   public:
     mf_graph() : _n(0) {}
     mf_graph(int n) : _n(n), g(n) {}
+    // Adds the edges of a graph in CSR form (e.g. amylase::csr_graph), edge i with the
+    // capacity cap(i), so that edge i here is edge i there. The adjacency lists are
+    // reserved from the degrees beforehand, and never reallocated.
+    template <class Graph, class CapOf>
+    mf_graph(const Graph& graph, CapOf cap) : mf_graph(graph.num_vertices()) {
+        std::vector<int> deg(_n);
+        for (int v = 0; v < _n; v++) {
+            deg[v] += graph.end(v) - graph.begin(v);
+            for (int i = graph.begin(v); i < graph.end(v); i++) deg[graph.to(i)]++;
+        }
+        for (int v = 0; v < _n; v++) g[v].reserve(deg[v]);
+        pos.reserve(graph.num_edges());
+        for (int v = 0; v < _n; v++) {
+            for (int i = graph.begin(v); i < graph.end(v); i++) {
+                add_edge(v, graph.to(i), cap(i));
+            }
+        }
+    }
 
     int add_edge(int from, int to, Cap cap) {
         assert(0 <= from && from < _n);
         assert(0 <= to && to < _n);
         assert(0 <= cap);
+        unfreeze();
         int m = int(pos.size());
         pos.push_back({from, int(g[from].size())});
         int from_id = int(g[from].size());
@@ -29,6 +49,23 @@ template <class Cap> struct mf_graph {
         return m;
     }
 
+    // Moves the arcs from the adjacency lists into one array (and releases the lists), which can
+    // make flow faster on large graphs. add_edge afterwards moves them back in O(n + m) time,
+    // so it should be called once all the edges are added.
+    void freeze() {
+        if (frozen) return;
+        start.assign(_n + 1, 0);
+        for (int v = 0; v < _n; v++) start[v + 1] = start[v] + int(g[v].size());
+        csr.clear();
+        csr.reserve(start[_n]);
+        for (int v = 0; v < _n; v++) {
+            csr.insert(csr.end(), g[v].begin(), g[v].end());
+            // release the list, so that the arcs are held only once
+            std::vector<_edge>().swap(g[v]);
+        }
+        frozen = true;
+    }
+
     struct edge {
         int from, to;
         Cap cap, flow;
@@ -37,8 +74,8 @@ template <class Cap> struct mf_graph {
     edge get_edge(int i) {
         int m = int(pos.size());
         assert(0 <= i && i < m);
-        auto _e = g[pos[i].first][pos[i].second];
-        auto _re = g[_e.to][_e.rev];
+        auto _e = arc(pos[i].first, pos[i].second);
+        auto _re = arc(_e.to, _e.rev);
         return edge{pos[i].first, _e.to, _e.cap + _re.cap, _re.cap};
     }
     std::vector<edge> edges() {
@@ -53,11 +90,26 @@ template <class Cap> struct mf_graph {
         int m = int(pos.size());
         assert(0 <= i && i < m);
         assert(0 <= new_flow && new_flow <= new_cap);
-        auto& _e = g[pos[i].first][pos[i].second];
-        auto& _re = g[_e.to][_e.rev];
+        auto& _e = arc(pos[i].first, pos[i].second);
+        auto& _re = arc(_e.to, _e.rev);
         _e.cap = new_cap - new_flow;
         _re.cap = new_flow;
     }
+    // Changes the capacity of the i-th edge, keeping the flows.
+    // If new_cap is less than the flow of the edge, the edge keeps its flow
+    // (and a capacity equal to it) until the next reflow.
+    void change_capacity(int i, Cap new_cap) {
+        int m = int(pos.size());
+        assert(0 <= i && i < m);
+        assert(0 <= new_cap);
+        auto e = get_edge(i);
+        if (pending.empty() && e.flow <= new_cap) {
+            change_edge(i, new_cap, e.flow);
+            return;
+        }
+        change_edge(i, std::max(new_cap, e.flow), e.flow);
+        pending.push_back({i, new_cap});
+    }
 
     Cap flow(int s, int t) {
         return flow(s, t, std::numeric_limits<Cap>::max());
@@ -66,7 +118,103 @@ template <class Cap> struct mf_graph {
         assert(0 <= s && s < _n);
         assert(0 <= t && t < _n);
         assert(s != t);
+        if (frozen) return dinic(csr_arcs{start, csr}, s, t, flow_limit);
+        return dinic(list_arcs{g}, s, t, flow_limit);
+    }
+
+    // Restores the flow from s to t after change_capacity, then augments it.
+    // The current flow must be a flow from s to t (e.g. the result of flow(s, t) and add_edge).
+    // For each edge whose capacity went below its flow, the excess is rerouted from its tail to
+    // its head along other paths, and the rest is pushed back from the tail to s and from t to the head.
+    // @return the value of the flow from s to t
+    Cap reflow(int s, int t) {
+        assert(0 <= s && s < _n);
+        assert(0 <= t && t < _n);
+        assert(s != t);
+        for (auto p : pending) {
+            int i = p.first;
+            Cap c = p.second;
+            auto e = get_edge(i);
+            // the flow of a self-loop never enters nor leaves its vertex
+            if (e.flow <= c || e.from == e.to) {
+                change_edge(i, c, std::min(e.flow, c));
+                continue;
+            }
+            Cap f = e.flow;
+            change_edge(i, f, f);
+            f -= flow(e.from, e.to, f - c);
+            Cap d = f - c;
+            change_edge(i, c, c);
+            if (d > 0) {
+                if (e.from != s && e.from != t) flow(e.from, s, d);
+                if (e.to != s && e.to != t) flow(t, e.to, d);
+            }
+        }
+        pending.clear();
+        flow(s, t);
+        Cap out = 0, in = 0;
+        for (int i = 0; i < int(pos.size()); i++) {
+            auto e = get_edge(i);
+            if (e.from == s) out += e.flow;
+            if (e.to == s) in += e.flow;
+        }
+        return out - in;
+    }
+
+    std::vector<bool> min_cut(int s) {
+        std::vector<bool> visited(_n);
+        internal::simple_queue<int> que;
+        que.push(s);
+        while (!que.empty()) {
+            int p = que.front();
+            que.pop();
+            visited[p] = true;
+            for (int i = 0; i < degree(p); i++) {
+                const _edge& e = arc(p, i);
+                if (e.cap && !visited[e.to]) {
+                    visited[e.to] = true;
+                    que.push(e.to);
+                }
+            }
+        }
+        return visited;
+    }
 
+  private:
+    int _n;
+    struct _edge {
+        int to, rev;
+        Cap cap;
+    };
+    std::vector<std::pair<int, int>> pos;
+    // the arcs from v are g[v][0], ..., g[v][g[v].size() - 1] while not frozen,
+    // and csr[start[v]], ..., csr[start[v + 1] - 1] (in the same order) while frozen
+    std::vector<std::vector<_edge>> g;
+    bool frozen = false;
+    std::vector<int> start;
+    std::vector<_edge> csr;
+    // the capacities set by change_capacity below the flows, applied by reflow
+    std::vector<std::pair<int, Cap>> pending;
+
+    _edge& arc(int v, int i) { return frozen ? csr[start[v] + i] : g[v][i]; }
+    int degree(int v) const {
+        return frozen ? start[v + 1] - start[v] : int(g[v].size());
+    }
+
+    // the arcs from v in either layout, as arcs(v)[0], ..., arcs(v)[arcs.size(v) - 1]
+    struct list_arcs {
+        std::vector<std::vector<_edge>>& g;
+        _edge* operator()(int v) const { return g[v].data(); }
+        int size(int v) const { return int(g[v].size()); }
+    };
+    struct csr_arcs {
+        const std::vector<int>& start;
+        std::vector<_edge>& csr;
+        _edge* operator()(int v) const { return csr.data() + start[v]; }
+        int size(int v) const { return start[v + 1] - start[v]; }
+    };
+
+    template <class Arcs> Cap dinic(Arcs arcs, int s, int t, Cap flow_limit) {
         std::vector<int> level(_n), iter(_n);
         internal::simple_queue<int> que;
 
@@ -78,7 +226,9 @@ template <class Cap> struct mf_graph {
             while (!que.empty()) {
                 int v = que.front();
                 que.pop();
-                for (auto e : g[v]) {
+                const _edge* arcs_v = arcs(v);
+                for (int i = 0; i < arcs.size(v); i++) {
+                    const _edge& e = arcs_v[i];
                     if (e.cap == 0 || level[e.to] >= 0) continue;
                     level[e.to] = level[v] + 1;
                     if (e.to == t) return;
@@ -86,31 +236,69 @@ template <class Cap> struct mf_graph {
                 }
             }
         };
-        auto dfs = [&](auto self, int v, Cap up) {
-            if (v == s) return up;
-            Cap res = 0;
-            int level_v = level[v];
-            for (int& i = iter[v]; i < int(g[v].size()); i++) {
-                _edge& e = g[v][i];
-                if (level_v <= level[e.to] || g[e.to][e.rev].cap == 0) continue;
-                Cap d =
-                    self(self, e.to, std::min(up - res, g[e.to][e.rev].cap));
-                if (d <= 0) continue;
-                g[v][i].cap += d;
-                g[e.to][e.rev].cap -= d;
-                res += d;
-                if (res == up) break;
+        // The search from t back to s, on an explicit stack of frames
+        // (v, up, res) instead of recursive calls, so that long augmenting
+        // paths do not overflow the call stack. The arc being tried at v is
+        // arcs(v)[iter[v]].
+        struct frame {
+            int v;
+            Cap up, res;
+        };
+        std::vector<frame> frames;
+        auto dfs = [&](Cap up) {
+            int depth = 0;
+            frames[0] = frame{t, up, 0};
+            while (true) {
+                frame& f = frames[depth];
+                int v = f.v;
+                int level_v = level[v], size_v = arcs.size(v);
+                _edge* arcs_v = arcs(v);
+                Cap up_v = f.up, res = f.res;
+                bool descended = false;
+                for (int& i = iter[v]; res < up_v && i < size_v; i++) {
+                    _edge& e = arcs_v[i];
+                    if (level_v <= level[e.to]) continue;
+                    _edge& re = arcs(e.to)[e.rev];
+                    if (re.cap == 0) continue;
+                    Cap d = std::min(up_v - res, re.cap);
+                    if (e.to != s) {
+                        frames[++depth] = frame{e.to, d, 0};
+                        descended = true;
+                        break;
+                    }
+                    e.cap += d;
+                    re.cap -= d;
+                    res += d;
+                    if (res == up_v) break;
+                }
+                f.res = res;
+                if (descended) continue;
+
+                Cap d = res;
+                if (depth == 0) return d;
+                frame& parent = frames[--depth];
+                int& i = iter[parent.v];
+                if (d > 0) {
+                    _edge& e = arcs(parent.v)[i];
+                    e.cap += d;
+                    arcs(e.to)[e.rev].cap -= d;
+                    parent.res += d;
+                    // the arc is tried again by the next search, as it may have capacity left
+                    if (parent.res == parent.up) continue;
+                }
+                i++;
             }
-            return res;
         };
 
         Cap flow = 0;
         while (flow < flow_limit) {
             bfs();
             if (level[t] == -1) break;
+            // the depth of the search is at most level[t]
+            if (int(frames.size()) <= level[t]) frames.resize(level[t] + 1);
             std::fill(iter.begin(), iter.end(), 0);
             while (flow < flow_limit) {
-                Cap f = dfs(dfs, t, flow_limit - flow);
+                Cap f = dfs(flow_limit - flow);
                 if (!f) break;
                 flow += f;
             }
@@ -118,32 +306,14 @@ template <class Cap> struct mf_graph {
         return flow;
     }
 
-    std::vector<bool> min_cut(int s) {
-        std::vector<bool> visited(_n);
-        internal::simple_queue<int> que;
-        que.push(s);
-        while (!que.empty()) {
-            int p = que.front();
-            que.pop();
-            visited[p] = true;
-            for (auto e : g[p]) {
-                if (e.cap && !visited[e.to]) {
-                    visited[e.to] = true;
-                    que.push(e.to);
-                }
-            }
+    void unfreeze() {
+        if (!frozen) return;
+        for (int v = 0; v < _n; v++) {
+            g[v].assign(csr.begin() + start[v], csr.begin() + start[v + 1]);
         }
-        return visited;
+        csr.clear();
+        frozen = false;
     }
-
-  private:
-    int _n;
-    struct _edge {
-        int to, rev;
-        Cap cap;
-    };
-    std::vector<std::pair<int, int>> pos;
-    std::vector<std::vector<_edge>> g;
 };
 
 }  // namespace atcoder
@@ -13,6 +13,24 @@ template <class Cap, class Cost> struct mcf_graph {
   public:
     mcf_graph() {}
     mcf_graph(int n) : _n(n), g(n) {}
+    // Adds the edges of a graph in CSR form (e.g. amylase::csr_graph), edge i with the
+    // capacity cap(i) and the cost cost(i), so that edge i here is edge i there.
+    // The adjacency lists are reserved from the degrees beforehand, and never reallocated.
+    template <class Graph, class CapOf, class CostOf>
+    mcf_graph(const Graph& graph, CapOf cap, CostOf cost) : mcf_graph(graph.num_vertices()) {
+        std::vector<int> deg(_n);
+        for (int v = 0; v < _n; v++) {
+            deg[v] += graph.end(v) - graph.begin(v);
+            for (int i = graph.begin(v); i < graph.end(v); i++) deg[graph.to(i)]++;
+        }
+        for (int v = 0; v < _n; v++) g[v].reserve(deg[v]);
+        pos.reserve(graph.num_edges());
+        for (int v = 0; v < _n; v++) {
+            for (int i = graph.begin(v); i < graph.end(v); i++) {
+                add_edge(v, graph.to(i), cap(i), cost(i));
+            }
+        }
+    }
 
     int add_edge(int from, int to, Cap cap, Cost cost) {
         assert(0 <= from && from < _n);
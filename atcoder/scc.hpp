@@ -22,6 +22,10 @@ struct scc_graph {
 
     std::vector<std::vector<int>> scc() { return internal.scc(); }
 
+    using condensation_graph = atcoder::internal::condensation_graph;
+
+    condensation_graph condensation() { return internal.condensation(); }
+
   private:
     internal::scc_graph internal;
 };
@@ -1,8 +1,12 @@
 #ifndef ATCODER_TWOSAT_HPP
 #define ATCODER_TWOSAT_HPP 1
 
+#include <algorithm>
 #include <atcoder/internal_scc>
 #include <cassert>
+#include <cstddef>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace atcoder {
@@ -13,29 +17,193 @@ namespace atcoder {
 // Formulas
 struct two_sat {
   public:
-    two_sat() : _n(0), scc(0) {}
-    two_sat(int n) : _n(n), _answer(n), scc(2 * n) {}
+    two_sat() : _n(0) {}
+    two_sat(int n) : _n(n), _answer(n) {}
+
+    // hint for the number of clauses which will be added
+    void reserve(int m) { clauses.reserve(2 * std::size_t(m)); }
+
+    int num_variables() const { return _n; }
+
+    // @return the index of a new variable
+    int add_variable() {
+        _answer.push_back(false);
+        return _n++;
+    }
 
     void add_clause(int i, bool f, int j, bool g) {
         assert(0 <= i && i < _n);
         assert(0 <= j && j < _n);
-        scc.add_edge(2 * i + (f ? 0 : 1), 2 * j + (g ? 1 : 0));
-        scc.add_edge(2 * j + (g ? 0 : 1), 2 * i + (f ? 1 : 0));
+        clauses.push_back(2 * i + (f ? 1 : 0));
+        clauses.push_back(2 * j + (g ? 1 : 0));
     }
-    bool satisfiable() {
-        auto id = scc.scc_ids().second;
-        for (int i = 0; i < _n; i++) {
-            if (id[2 * i] == id[2 * i + 1]) return false;
-            _answer[i] = id[2 * i] < id[2 * i + 1];
+
+    // Adds the clauses that at most one of (x_i = f) for (i, f) in literals holds.
+    // With more than 4 literals, it uses the sequential encoding:
+    // it adds k - 1 variables s_0, ..., s_{k - 2} (s_p: one of the first p + 1 literals holds)
+    // and 3k - 4 clauses, instead of k(k - 1) / 2.
+    //
+    // Reference:
+    // C. Sinz,
+    // Towards an Optimal CNF Encoding of Boolean Cardinality Constraints
+    void at_most_one(const std::vector<std::pair<int, bool>>& literals) {
+        int k = int(literals.size());
+        for (auto l : literals) {
+            assert(0 <= l.first && l.first < _n);
+        }
+        if (k <= 4) {
+            for (int p = 0; p < k; p++) {
+                for (int q = p + 1; q < k; q++) {
+                    add_clause(literals[p].first, !literals[p].second,
+                               literals[q].first, !literals[q].second);
+                }
+            }
+            return;
+        }
+        int prev = -1;
+        for (int p = 0; p < k; p++) {
+            int i = literals[p].first;
+            bool f = literals[p].second;
+            // s_{p - 1} -> not l_p
+            if (prev != -1) add_clause(prev, false, i, !f);
+            if (p == k - 1) break;
+            int cur = add_variable();
+            // l_p -> s_p, s_{p - 1} -> s_p
+            add_clause(i, !f, cur, true);
+            if (prev != -1) add_clause(prev, false, cur, true);
+            prev = cur;
+        }
+    }
+
+    bool satisfiable() { return solve(false); }
+
+    // Decides whether all the clauses and (x_i = f) for all (i, f) in assumptions hold at once,
+    // and answer() returns such an assignment if so.
+    // The first call after adding clauses or variables solves the clauses and keeps the DAG of
+    // the strongly connected components of the implication graph. Later calls only visit
+    // the components implied by the assumptions: the assumptions are consistent iff those
+    // components contain no literal together with its negation, and then the assignment of
+    // satisfiable() with these literals overwritten satisfies everything.
+    bool satisfiable(const std::vector<std::pair<int, bool>>& assumptions) {
+        if (dag_n != _n || dag_clauses != clauses.size()) solve(true);
+        for (int i : patched) _answer[i] = base_answer[i];
+        patched.clear();
+        if (!base_ok) return false;
+        if (stamp == std::numeric_limits<int>::max()) {
+            std::fill(seen.begin(), seen.end(), 0);
+            stamp = 0;
+        }
+        stamp++;
+        visited.clear();
+        for (auto l : assumptions) {
+            assert(0 <= l.first && l.first < _n);
+            int c = ids[2 * l.first + (l.second ? 1 : 0)];
+            if (seen[c] == stamp) continue;
+            seen[c] = stamp;
+            visited.push_back(c);
+        }
+        for (std::size_t h = 0; h < visited.size(); h++) {
+            int c = visited[h];
+            if (seen[neg[c]] == stamp) return false;
+            for (int e = dag_start[c]; e < dag_start[c + 1]; e++) {
+                int d = dag_elist[e];
+                if (seen[d] == stamp) continue;
+                seen[d] = stamp;
+                visited.push_back(d);
+            }
+        }
+        for (int c : visited) {
+            for (int e = member_start[c]; e < member_start[c + 1]; e++) {
+                int v = members[e];
+                _answer[v >> 1] = v & 1;
+                patched.push_back(v >> 1);
+            }
         }
         return true;
     }
+
     std::vector<bool> answer() { return _answer; }
 
   private:
     int _n;
     std::vector<bool> _answer;
-    internal::scc_graph scc;
+    // the literals of the clauses, two per clause; (x_i = f) is 2i + f
+    std::vector<int> clauses;
+
+    // state kept for satisfiable(assumptions), valid while _n == dag_n and clauses.size() == dag_clauses
+    int dag_n = -1;
+    std::size_t dag_clauses = 0;
+    bool base_ok = false;
+    std::vector<bool> base_answer;
+    // ids: component of each vertex, neg: component of the negations of the component,
+    // the DAG (without duplicate edges) and the vertices of each component in CSR form
+    std::vector<int> ids, neg, dag_start, dag_elist, member_start, members;
+    std::vector<int> seen, visited, patched;
+    int stamp = 0;
+
+    bool solve(bool keep_dag) {
+        patched.clear();
+        // the clause (a or b) is the edges (not a -> b) and (not b -> a),
+        // where the vertex 2i + 1 is (x_i = true) and 2i is (x_i = false)
+        std::vector<int> start(2 * _n + 1), elist(clauses.size());
+        for (auto a : clauses) start[(a ^ 1) + 1]++;
+        for (int v = 0; v < 2 * _n; v++) start[v + 1] += start[v];
+        {
+            std::vector<int> counter(start.begin(), start.end() - 1);
+            for (std::size_t c = 0; c < clauses.size(); c += 2) {
+                int a = clauses[c], b = clauses[c + 1];
+                elist[counter[a ^ 1]++] = b;
+                elist[counter[b ^ 1]++] = a;
+            }
+        }
+        auto scc = internal::scc_ids_csr(2 * _n, start, [&](int e) { return elist[e]; });
+        auto& id = scc.second;
+        bool ok = true;
+        for (int i = 0; i < _n; i++) {
+            if (id[2 * i] == id[2 * i + 1]) {
+                ok = false;
+                break;
+            }
+            _answer[i] = id[2 * i] < id[2 * i + 1];
+        }
+        if (!keep_dag) return ok;
+
+        dag_n = _n;
+        dag_clauses = clauses.size();
+        base_ok = ok;
+        base_answer = _answer;
+        int k = scc.first;
+        member_start.assign(k + 1, 0);
+        members.resize(2 * _n);
+        for (int v = 0; v < 2 * _n; v++) member_start[id[v] + 1]++;
+        for (int c = 0; c < k; c++) member_start[c + 1] += member_start[c];
+        {
+            std::vector<int> counter(member_start.begin(), member_start.end() - 1);
+            for (int v = 0; v < 2 * _n; v++) members[counter[id[v]]++] = v;
+        }
+        neg.resize(k);
+        dag_start.assign(k + 1, 0);
+        dag_elist.clear();
+        std::vector<int> last(k, -1);
+        for (int c = 0; c < k; c++) {
+            neg[c] = id[members[member_start[c]] ^ 1];
+            last[c] = c;
+            for (int e = member_start[c]; e < member_start[c + 1]; e++) {
+                int v = members[e];
+                for (int f = start[v]; f < start[v + 1]; f++) {
+                    int d = id[elist[f]];
+                    if (last[d] == c) continue;
+                    last[d] = c;
+                    dag_elist.push_back(d);
+                }
+            }
+            dag_start[c + 1] = int(dag_elist.size());
+        }
+        ids = std::move(id);
+        seen.assign(k, 0);
+        stamp = 0;
+        return ok;
+    }
 };
 
 }  // namespace atcoder
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <amylase/compact_lazy_segtree>
+#include <amylase/segtrees>
+#include <atcoder/modint>
+#include "../utils/random.hpp"
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// S is not commutative: it checks the order of the operands.
+struct S {
+    int l, r, time;
+};
+
+struct T {
+    int new_time;
+};
+
+S op_ss(S l, S r) {
+    if (l.l == -1) return r;
+    if (r.l == -1) return l;
+    assert(l.r == r.l);
+    return S{l.l, r.r, std::max(l.time, r.time)};
+}
+
+S op_ts(T l, S r) {
+    if (l.new_time == -1) return r;
+    assert(r.time < l.new_time);
+    return S{r.l, r.r, l.new_time};
+}
+
+T op_tt(T l, T r) {
+    if (l.new_time == -1) return r;
+    if (r.new_time == -1) return l;
+    assert(l.new_time > r.new_time);
+    return l;
+}
+
+S e_s() { return S{-1, -1, -1}; }
+
+T e_t() { return T{-1}; }
+
+using mint = atcoder::modint998244353;
+
+using seg = amylase::compact_lazy_segtree<S, op_ss, e_s, T, op_ts, op_tt, e_t>;
+
+TEST(CompactLazySegtreeTest, Zero) {
+    seg s0;
+    ASSERT_EQ(-1, s0.all_prod().l);
+    seg s1(0);
+    ASSERT_EQ(0, s1.max_right(0, [](S) { return true; }));
+    ASSERT_EQ(0, s1.min_left(0, [](S) { return true; }));
+}
+
+TEST(CompactLazySegtreeTest, Layout) {
+    static_assert(std::is_same<amylase::min_sum_segtree<int, true>,
+                               amylase::compact_lazy_segtree<int, amylase::min<int>, std::numeric_limits<int>::max,
+                                                             int, amylase::add<int>, amylase::add<int>, amylase::zero<int>>>::value,
+                  "compact flag selects compact_lazy_segtree");
+    static_assert(std::is_same<amylase::min_sum_segtree<int>,
+                               atcoder::lazy_segtree<int, amylase::min<int>, std::numeric_limits<int>::max,
+                                                     int, amylase::add<int>, amylase::add<int>, amylase::zero<int>>>::value,
+                  "default is atcoder::lazy_segtree");
+    amylase::min_sum_segtree<int, true> s(std::vector<int>{3, 1, 4, 1, 5});
+    s.apply(1, 4, 10);
+    ASSERT_EQ(3, s.all_prod());
+    ASSERT_EQ(11, s.prod(1, 4));
+    ASSERT_EQ(5, s.get(4));
+}
+
+TEST(CompactLazySegtreeTest, Naive) {
+    for (int n = 1; n <= 30; n++) {
+        for (int ph = 0; ph < 10; ph++) {
+            seg seg0(n);
+            std::vector<int> tm(n, -1);
+            for (int i = 0; i < n; i++) seg0.set(i, S{i, i + 1, -1});
+            int now = 0;
+            for (int q = 0; q < 3000; q++) {
+                int ty = randint(0, 5);
+                int l, r;
+                std::tie(l, r) = randpair(0, n);
+                if (ty == 0) {
+                    auto res = seg0.prod(l, r);
+                    ASSERT_EQ(l, res.l);
+                    ASSERT_EQ(r, res.r);
+                    ASSERT_EQ(*std::max_element(tm.begin() + l, tm.begin() + r), res.time);
+                } else if (ty == 1) {
+                    auto res = seg0.get(l);
+                    ASSERT_EQ(l, res.l);
+                    ASSERT_EQ(l + 1, res.r);
+                    ASSERT_EQ(tm[l], res.time);
+                } else if (ty == 2) {
+                    now++;
+                    seg0.apply(l, r, T{now});
+                    for (int i = l; i < r; i++) tm[i] = now;
+                } else if (ty == 3) {
+                    now++;
+                    seg0.apply(l, T{now});
+                    tm[l] = now;
+                } else if (ty == 4) {
+                    ASSERT_EQ(r, seg0.max_right(l, [&](S s) {
+                        if (s.l == -1) return true;
+                        assert(s.l == l);
+                        assert(s.time == *std::max_element(tm.begin() + l, tm.begin() + s.r));
+                        return s.r <= r;
+                    }));
+                } else {
+                    ASSERT_EQ(l, seg0.min_left(r, [&](S s) {
+                        if (s.l == -1) return true;
+                        assert(s.r == r);
+                        assert(s.time == *std::max_element(tm.begin() + s.l, tm.begin() + r));
+                        return l <= s.l;
+                    }));
+                }
+            }
+            auto all = seg0.all_prod();
+            ASSERT_EQ(0, all.l);
+            ASSERT_EQ(n, all.r);
+        }
+    }
+}
+
+TEST(CompactLazySegtreeTest, Large) {
+    // n = 2^k + 1 and 2^k - 1 have the longest chains of nodes which span the wrap
+    for (int n : {1025, 1023, 1000, 1024}) {
+        std::vector<amylase::sum_node<mint>> v(n, amylase::sum_node<mint>(1));
+        amylase::sum_affine_segtree<mint, true> s(v);
+        amylase::sum_affine_segtree<mint> t(v);
+        for (int q = 0; q < 3000; q++) {
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            if (randbool()) {
+                amylase::affine_action<mint> f{randint(0, 100), randint(0, 100)};
+                s.apply(l, r, f);
+                t.apply(l, r, f);
+            } else {
+                ASSERT_EQ(t.prod(l, r).sum.val(), s.prod(l, r).sum.val());
+            }
+        }
+        ASSERT_EQ(t.all_prod().sum.val(), s.all_prod().sum.val());
+    }
+}
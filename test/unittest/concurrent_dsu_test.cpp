@@ -0,0 +1,96 @@
+#include <amylase/concurrent_dsu>
+#include <atcoder/dsu>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+namespace {
+
+// groups of atcoder::dsu, sorted by the smallest element
+std::vector<std::vector<int>> sorted_groups(atcoder::dsu& uf) {
+    auto g = uf.groups();
+    std::sort(g.begin(), g.end());
+    return g;
+}
+
+}  // namespace
+
+TEST(ConcurrentDSUTest, Zero) {
+    amylase::concurrent_dsu uf(0);
+    ASSERT_EQ(std::vector<std::vector<int>>(), uf.groups());
+    amylase::concurrent_dsu uf2;
+    ASSERT_EQ(std::vector<std::vector<int>>(), uf2.groups());
+}
+
+TEST(ConcurrentDSUTest, Simple) {
+    amylase::concurrent_dsu uf(3);
+    ASSERT_FALSE(uf.same(1, 2));
+    ASSERT_EQ(1, uf.merge(2, 1));
+    ASSERT_EQ(1, uf.leader(2));
+    ASSERT_TRUE(uf.same(1, 2));
+    ASSERT_FALSE(uf.same(0, 2));
+    ASSERT_EQ(0, uf.merge(1, 0));
+    ASSERT_EQ(0, uf.leader(2));
+    ASSERT_EQ(std::vector<std::vector<int>>({{0, 1, 2}}), uf.groups());
+}
+
+TEST(ConcurrentDSUTest, Line) {
+    int n = 500000;
+    amylase::concurrent_dsu uf(n);
+    for (int i = n - 2; i >= 0; i--) uf.merge(i, i + 1);
+    ASSERT_EQ(0, uf.leader(n - 1));
+    ASSERT_EQ(1, uf.groups().size());
+}
+
+TEST(ConcurrentDSUTest, Naive) {
+    for (int n = 1; n <= 30; n++) {
+        amylase::concurrent_dsu uf(n);
+        atcoder::dsu expected(n);
+        for (int ph = 0; ph < 100; ph++) {
+            int a = randint(0, n - 1), b = randint(0, n - 1);
+            if (randbool()) {
+                int x = uf.merge(a, b);
+                expected.merge(a, b);
+                ASSERT_EQ(x, uf.leader(a));
+                ASSERT_EQ(x, uf.leader(b));
+            } else {
+                ASSERT_EQ(expected.same(a, b), uf.same(a, b));
+            }
+        }
+        ASSERT_EQ(sorted_groups(expected), uf.groups());
+    }
+}
+
+TEST(ConcurrentDSUTest, MultiThread) {
+    const int n = 100000, m = 150000, threads = 8;
+    std::vector<std::pair<int, int>> edges(m);
+    for (auto& e : edges) e = {randint(0, n - 1), randint(0, n - 1)};
+
+    amylase::concurrent_dsu uf(n);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (int i = t; i < m; i += threads) uf.merge(edges[i].first, edges[i].second);
+        });
+    }
+    // the endpoints of an edge become connected once and for all
+    std::thread reader([&]() {
+        for (int i = 0; i < m; i += 7) {
+            if (uf.same(edges[i].first, edges[i].second)) {
+                ASSERT_TRUE(uf.same(edges[i].first, edges[i].second));
+            }
+            uf.leader(edges[i].first);
+        }
+    });
+    for (auto& w : workers) w.join();
+    reader.join();
+
+    atcoder::dsu expected(n);
+    for (auto e : edges) expected.merge(e.first, e.second);
+    for (auto e : edges) ASSERT_TRUE(uf.same(e.first, e.second));
+    ASSERT_EQ(sorted_groups(expected), uf.groups());
+}
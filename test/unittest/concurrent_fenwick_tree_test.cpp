@@ -0,0 +1,78 @@
+#include <amylase/concurrent_fenwick_tree>
+#include <atcoder/fenwicktree>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using ll = long long;
+
+TEST(ConcurrentFenwickTreeTest, Empty) {
+    amylase::concurrent_fenwick_tree<ll> fw;
+    ASSERT_EQ(0, fw.sum(0, 0));
+    amylase::concurrent_fenwick_tree<ll> fw2(0, 4);
+    ASSERT_EQ(0, fw2.sum(0, 0));
+}
+
+TEST(ConcurrentFenwickTreeTest, SingleThread) {
+    for (int stripes = 1; stripes <= 3; stripes++) {
+        for (int n = 0; n <= 30; n++) {
+            amylase::concurrent_fenwick_tree<ll> fw(n, stripes);
+            atcoder::fenwick_tree<ll> expected(n);
+            for (int i = 0; i < n; i++) {
+                fw.add(i, i * i - 10, i % stripes);
+                expected.add(i, i * i - 10);
+            }
+            for (int l = 0; l <= n; l++) {
+                for (int r = l; r <= n; r++) ASSERT_EQ(expected.sum(l, r), fw.sum(l, r));
+            }
+        }
+    }
+}
+
+TEST(ConcurrentFenwickTreeTest, Bound) {
+    amylase::concurrent_fenwick_tree<int> fw(10);
+    fw.add(3, std::numeric_limits<int>::max());
+    fw.add(5, std::numeric_limits<int>::min());
+    ASSERT_EQ(-1, fw.sum(0, 10));
+    ASSERT_EQ(std::numeric_limits<int>::max(), fw.sum(3, 4));
+}
+
+TEST(ConcurrentFenwickTreeTest, MultiThread) {
+    const int n = 1000, threads = 8, per_thread = 20000;
+    for (int stripes : {1, 4}) {
+        amylase::concurrent_fenwick_tree<ll> fw(n, stripes);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&fw, t]() {
+                for (int i = 0; i < per_thread; i++) fw.add((i * 7 + t) % n, t + 1);
+            });
+        }
+        // every added value is positive, so the total read while the writers run never decreases,
+        // and never exceeds the total after they finish
+        ll last = 0;
+        for (int q = 0; q < 1000; q++) {
+            ll now = fw.sum(0, n);
+            ASSERT_LE(last, now);
+            last = now;
+        }
+        for (auto& w : workers) w.join();
+        ASSERT_LE(last, fw.sum(0, n));
+        ASSERT_EQ(ll(threads) * (threads + 1) / 2 * per_thread, fw.sum(0, n));
+
+        std::vector<ll> expected(n);
+        for (int t = 0; t < threads; t++) {
+            for (int i = 0; i < per_thread; i++) expected[(i * 7 + t) % n] += t + 1;
+        }
+        for (int l = 0; l <= n; l += 37) {
+            ll sum = 0;
+            for (int r = l; r <= n; r++) {
+                if (r > l) sum += expected[r - 1];
+                if (r % 13 == 0) {
+                    ASSERT_EQ(sum, fw.sum(l, r));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#include <amylase/csr_graph>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <atcoder/scc>
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+using namespace amylase;
+
+namespace {
+
+struct weight {
+    int cap;
+    long long cost;
+};
+
+struct temp_file {
+    std::string path;
+    temp_file(const std::string& name) : path(name) {}
+    ~temp_file() { std::remove(path.c_str()); }
+};
+
+}  // namespace
+
+TEST(CSRGraphTest, Empty) {
+    csr_graph<> g;
+    ASSERT_EQ(0, g.num_vertices());
+    ASSERT_EQ(0, g.num_edges());
+    csr_graph_builder<> builder(3);
+    auto h = builder.build();
+    ASSERT_EQ(3, h.num_vertices());
+    ASSERT_EQ(0, h.num_edges());
+    for (int v = 0; v < 3; v++) ASSERT_EQ(h.begin(v), h.end(v));
+}
+
+TEST(CSRGraphTest, Build) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = randint(1, 50);
+        int m = randint(0, 200);
+        csr_graph_builder<weight> builder(n);
+        builder.reserve(m);
+        std::vector<std::vector<std::pair<int, int>>> expected(n);
+        for (int i = 0; i < m; i++) {
+            int a = randint(0, n - 1), b = randint(0, n - 1);
+            ASSERT_EQ(i, builder.add_edge(a, b, {i, 2LL * i}));
+            expected[a].push_back({b, i});
+        }
+        auto g = builder.build();
+        ASSERT_EQ(n, g.num_vertices());
+        ASSERT_EQ(m, g.num_edges());
+        for (int v = 0; v < n; v++) {
+            std::vector<std::pair<int, int>> actual;
+            for (int i = g.begin(v); i < g.end(v); i++) {
+                ASSERT_EQ(2LL * g.payload(i).cap, g.payload(i).cost);
+                actual.push_back({g.to(i), g.payload(i).cap});
+            }
+            ASSERT_EQ(expected[v], actual);
+        }
+    }
+}
+
+TEST(CSRGraphTest, SaveAndOpen) {
+    int n = 1000, m = 5000;
+    csr_graph_builder<weight> builder(n);
+    for (int i = 0; i < m; i++) builder.add_edge(randint(0, n - 1), randint(0, n - 1), {randint(0, 100), i});
+    auto g = builder.build();
+    temp_file tmp("csr_graph_test_0.bin");
+    ASSERT_TRUE(g.save(tmp.path));
+
+    csr_graph<weight> h;
+    ASSERT_TRUE(h.open_mapped(tmp.path));
+    ASSERT_EQ(n, h.num_vertices());
+    ASSERT_EQ(m, h.num_edges());
+    for (int v = 0; v < n; v++) {
+        ASSERT_EQ(g.begin(v), h.begin(v));
+        ASSERT_EQ(g.end(v), h.end(v));
+    }
+    for (int i = 0; i < m; i++) {
+        ASSERT_EQ(g.to(i), h.to(i));
+        ASSERT_EQ(g.payload(i).cap, h.payload(i).cap);
+        ASSERT_EQ(g.payload(i).cost, h.payload(i).cost);
+    }
+
+    // the updates of a mapped graph are private
+    h.payload(0).cap = -1;
+    csr_graph<weight> h2;
+    ASSERT_TRUE(h2.open_mapped(tmp.path));
+    ASSERT_EQ(g.payload(0).cap, h2.payload(0).cap);
+
+    // copies and moves keep the contents
+    auto copied = h;
+    auto moved = std::move(h2);
+    ASSERT_EQ(-1, copied.payload(0).cap);
+    ASSERT_EQ(g.payload(0).cap, moved.payload(0).cap);
+    ASSERT_EQ(g.to(m - 1), moved.to(m - 1));
+
+    // another payload, or no payload
+    csr_graph<> unweighted;
+    ASSERT_FALSE(unweighted.open_mapped(tmp.path));
+    ASSERT_EQ(0, unweighted.num_vertices());
+    ASSERT_FALSE(unweighted.open_mapped("csr_graph_test_missing.bin"));
+}
+
+TEST(CSRGraphTest, SaveAndOpenUnweighted) {
+    std::vector<std::pair<int, int>> edges = {{2, 0}, {0, 1}, {2, 1}, {0, 2}};
+    csr_graph<> g(3, edges);
+    temp_file tmp("csr_graph_test_1.bin");
+    ASSERT_TRUE(g.save(tmp.path));
+    csr_graph<> h;
+    ASSERT_TRUE(h.open_mapped(tmp.path));
+    ASSERT_EQ(3, h.num_vertices());
+    ASSERT_EQ(4, h.num_edges());
+    std::vector<int> to;
+    for (int i = 0; i < h.num_edges(); i++) to.push_back(h.to(i));
+    ASSERT_EQ(std::vector<int>({1, 2, 0, 1}), to);
+}
+
+TEST(CSRGraphTest, OpenCorrupted) {
+    std::vector<std::pair<int, int>> edges = {{2, 0}, {0, 1}, {2, 1}, {0, 2}};
+    csr_graph<> g(3, edges);
+    auto h = csr_header::make(0, 3, 4);
+    // (offset, value): start = {0, 2, 2, 4}, to = {1, 2, 0, 1}
+    std::vector<std::pair<std::size_t, int>> corruptions = {
+        {h.start_offset, 1},                    // start[0] != 0
+        {h.start_offset + sizeof(int) * 2, 1},  // start[1] > start[2]
+        {h.start_offset + sizeof(int) * 3, 3},  // start[n] != m
+        {h.to_offset + sizeof(int) * 1, 3},     // to >= n
+        {h.to_offset + sizeof(int) * 2, -1},    // to < 0
+    };
+    for (auto c : corruptions) {
+        temp_file tmp("csr_graph_test_3.bin");
+        ASSERT_TRUE(g.save(tmp.path));
+        std::FILE* fp = std::fopen(tmp.path.c_str(), "r+b");
+        ASSERT_NE(nullptr, fp);
+        ASSERT_EQ(0, std::fseek(fp, long(c.first), SEEK_SET));
+        ASSERT_EQ(1u, std::fwrite(&c.second, sizeof(int), 1, fp));
+        ASSERT_EQ(0, std::fclose(fp));
+        csr_graph<> opened(3, {{0, 0}});
+        ASSERT_FALSE(opened.open_mapped(tmp.path));
+        ASSERT_EQ(3, opened.num_vertices());
+        ASSERT_EQ(1, opened.num_edges());
+    }
+
+    // offsets which wrap around when the array size is added
+    std::uint64_t wrapped = ~std::uint64_t(63);
+    std::vector<std::pair<int, int>> many;
+    for (int i = 0; i < 200; i++) many.push_back({i % 100, i / 2});
+    csr_graph<> large(100, many);
+    for (std::size_t field : {offsetof(csr_header, start_offset), offsetof(csr_header, to_offset)}) {
+        temp_file tmp("csr_graph_test_3.bin");
+        ASSERT_TRUE(large.save(tmp.path));
+        std::FILE* fp = std::fopen(tmp.path.c_str(), "r+b");
+        ASSERT_NE(nullptr, fp);
+        ASSERT_EQ(0, std::fseek(fp, long(field), SEEK_SET));
+        ASSERT_EQ(1u, std::fwrite(&wrapped, sizeof(wrapped), 1, fp));
+        ASSERT_EQ(0, std::fclose(fp));
+        csr_graph<> opened;
+        ASSERT_FALSE(opened.open_mapped(tmp.path));
+        ASSERT_EQ(0, opened.num_vertices());
+    }
+    csr_header w = csr_header::make(sizeof(weight), 100, 200);
+    w.payload_offset = wrapped;
+    ASSERT_FALSE(w.valid(sizeof(weight), 1 << 20));
+}
+
+TEST(CSRGraphTest, SCC) {
+    for (int ph = 0; ph < 100; ph++) {
+        int n = randint(1, 50);
+        int m = randint(0, 100);
+        atcoder::scc_graph expected(n);
+        csr_graph_builder<> builder(n);
+        for (int i = 0; i < m; i++) {
+            int a = randint(0, n - 1), b = randint(0, n - 1);
+            expected.add_edge(a, b);
+            builder.add_edge(a, b);
+        }
+        auto g = builder.build();
+        ASSERT_EQ(expected.scc(), scc(g));
+
+        temp_file tmp("csr_graph_test_2.bin");
+        ASSERT_TRUE(g.save(tmp.path));
+        csr_graph<> h;
+        ASSERT_TRUE(h.open_mapped(tmp.path));
+        ASSERT_EQ(expected.scc(), scc(h));
+    }
+}
@@ -1,8 +1,11 @@
 #include <atcoder/dsu>
 #include <numeric>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "../utils/random.hpp"
+
 using namespace atcoder;
 using ll = long long;
 using ull = unsigned long long;
@@ -51,3 +54,27 @@ TEST(DSUTest, LineReverse) {
     ASSERT_EQ(n, uf.size(0));
     ASSERT_EQ(1, uf.groups().size());
 }
+
+TEST(DSUTest, GroupsCSR) {
+    dsu uf0(0);
+    ASSERT_EQ(std::vector<int>({0}), uf0.groups_csr().first);
+    ASSERT_EQ(std::vector<int>(), uf0.groups_csr().second);
+
+    for (int n = 1; n <= 30; n++) {
+        dsu uf(n);
+        for (int ph = 0; ph < 40; ph++) {
+            uf.merge(randint(0, n - 1), randint(0, n - 1));
+            auto groups = uf.groups();
+            auto csr = uf.groups_csr();
+            ASSERT_EQ(groups.size() + 1, csr.first.size());
+            ASSERT_EQ(n, int(csr.second.size()));
+            for (int i = 0; i < int(groups.size()); i++) {
+                std::vector<int> members(csr.second.begin() + csr.first[i],
+                                         csr.second.begin() + csr.first[i + 1]);
+                ASSERT_EQ(groups[i], members);
+                ASSERT_EQ(uf.size(members[0]), int(members.size()));
+                for (int v : members) ASSERT_EQ(uf.leader(members[0]), uf.leader(v));
+            }
+        }
+    }
+}
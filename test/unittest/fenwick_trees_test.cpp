@@ -0,0 +1,178 @@
+#include <amylase/fenwick_trees>
+#include <atcoder/modint>
+#include "../utils/random.hpp"
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using ll = long long;
+using ull = unsigned long long;
+
+TEST(FenwickTreesTest, RangeEmpty) {
+    amylase::range_fenwick_tree<ll> fw;
+    ASSERT_EQ(0, fw.sum(0, 0));
+    amylase::range_fenwick_tree<atcoder::modint998244353> fw_modint(0);
+    ASSERT_EQ(0, fw_modint.sum(0, 0).val());
+}
+
+TEST(FenwickTreesTest, RangeNaive) {
+    for (int n = 0; n <= 30; n++) {
+        std::vector<ll> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        amylase::range_fenwick_tree<ll> fw(a);
+        for (int q = 0; q < 300; q++) {
+            int l = randint(0, n), r = randint(0, n);
+            if (l > r) std::swap(l, r);
+            if (randbool()) {
+                ll x = randint(-100, 100);
+                fw.add(l, r, x);
+                for (int i = l; i < r; i++) a[i] += x;
+            } else {
+                ll sum = 0;
+                for (int i = l; i < r; i++) sum += a[i];
+                ASSERT_EQ(sum, fw.sum(l, r));
+                if (l < n) {
+                    ASSERT_EQ(a[l], fw.get(l));
+                }
+            }
+        }
+    }
+}
+
+TEST(FenwickTreesTest, RangeModint) {
+    using mint = atcoder::modint998244353;
+    const int n = 20;
+    std::vector<mint> a(n);
+    amylase::range_fenwick_tree<mint> fw(n);
+    for (int q = 0; q < 1000; q++) {
+        int l = randint(0, n), r = randint(0, n);
+        if (l > r) std::swap(l, r);
+        mint x = randint(0, 1'000'000'000);
+        fw.add(l, r, x);
+        for (int i = l; i < r; i++) a[i] += x;
+        mint sum = 0;
+        for (int i = l; i < r; i++) sum += a[i];
+        ASSERT_EQ(sum, fw.sum(l, r));
+    }
+}
+
+TEST(FenwickTreesTest, RangeOverflow) {
+    amylase::range_fenwick_tree<int> fw(10);
+    fw.add(0, 10, std::numeric_limits<int>::max());
+    fw.add(5, 10, std::numeric_limits<int>::min());
+    ASSERT_EQ(std::numeric_limits<int>::max(), fw.sum(4, 5));
+    ASSERT_EQ(-1, fw.sum(7, 8));
+    ASSERT_EQ(-5, fw.sum(5, 10));
+    // 5 * max wraps to max - 4
+    ASSERT_EQ(std::numeric_limits<int>::max() - 4, fw.sum(0, 5));
+
+    amylase::range_fenwick_tree<ull> fw_ull(4);
+    fw_ull.add(0, 4, 1ULL << 63);
+    ASSERT_EQ(1ULL << 63, fw_ull.sum(1, 2));
+    ASSERT_EQ(0ULL, fw_ull.sum(0, 4));
+}
+
+TEST(FenwickTreesTest, RectangleEmpty) {
+    amylase::rectangle_fenwick_tree<int, ll> fw;
+    ASSERT_EQ(0, fw.sum(0, 10, 0, 10));
+    amylase::rectangle_fenwick_tree<int, ll> fw2({{1, 1}});
+    ASSERT_EQ(0, fw2.sum(0, 10, 0, 10));
+}
+
+TEST(FenwickTreesTest, RectangleNaive) {
+    for (int n = 1; n <= 50; n++) {
+        std::vector<std::pair<int, int>> points(n);
+        for (auto& p : points) p = {randint(-10, 10), randint(-10, 10)};
+        amylase::rectangle_fenwick_tree<int, ll> fw(points);
+        std::vector<ll> w(n);
+        for (int q = 0; q < 500; q++) {
+            if (randbool()) {
+                int i = randint(0, n - 1);
+                ll x = randint(-100, 100);
+                fw.add(points[i].first, points[i].second, x);
+                w[i] += x;
+            } else {
+                int xl = randint(-11, 11), xr = randint(-11, 11);
+                int yl = randint(-11, 11), yr = randint(-11, 11);
+                ll sum = 0;
+                for (int i = 0; i < n; i++) {
+                    if (xl <= points[i].first && points[i].first < xr &&
+                        yl <= points[i].second && points[i].second < yr) {
+                        sum += w[i];
+                    }
+                }
+                ASSERT_EQ(sum, fw.sum(xl, xr, yl, yr));
+            }
+        }
+    }
+}
+
+TEST(FenwickTreesTest, RectangleLargeCoordinates) {
+    std::vector<std::pair<ll, ll>> points;
+    for (int i = 0; i < 1000; i++) {
+        points.emplace_back(randint(-1'000'000'000LL, 1'000'000'000LL), randint(-1'000'000'000LL, 1'000'000'000LL));
+    }
+    amylase::rectangle_fenwick_tree<ll, ull> fw(points);
+    for (auto& p : points) fw.add(p.first, p.second, 1);
+    ASSERT_EQ(1000ULL, fw.sum(-1'000'000'000LL, 1'000'000'001LL, -1'000'000'000LL, 1'000'000'001LL));
+    ull expected = 0;
+    for (auto& p : points) expected += (p.first < 0 && p.second >= 0);
+    ASSERT_EQ(expected, fw.sum(-1'000'000'000LL, 0, 0, 1'000'000'001LL));
+}
+
+TEST(FenwickTreesTest, PaddedNaive) {
+    for (int n = 0; n <= 3000; n += randint(1, 50)) {
+        amylase::padded_fenwick_tree<ll> fw(n);
+        std::vector<ll> a(n);
+        for (int q = 0; q < 100; q++) {
+            if (n > 0 && randbool()) {
+                int p = randint(0, n - 1);
+                ll x = randint(-100, 100);
+                fw.add(p, x);
+                a[p] += x;
+            } else {
+                int l = randint(0, n), r = randint(0, n);
+                if (l > r) std::swap(l, r);
+                ll sum = 0;
+                for (int i = l; i < r; i++) sum += a[i];
+                ASSERT_EQ(sum, fw.sum(l, r));
+            }
+        }
+    }
+}
+
+TEST(FenwickTreesTest, PaddedLarge) {
+    // with and without huge pages
+    for (int n : {1023, 1024, 1025, 65535, 1 << 20, 3'000'017}) {
+        amylase::padded_fenwick_tree<ull> fw(n, n % 2 == 1);
+        amylase::padded_fenwick_tree<atcoder::modint998244353> fw_modint(n);
+        std::vector<std::pair<int, ull>> updates;
+        for (int q = 0; q < 1000; q++) {
+            int p = randint(0, n - 1);
+            ull x = randint(0ULL, ~0ULL);
+            fw.add(p, x);
+            fw_modint.add(p, x);
+            updates.emplace_back(p, x);
+        }
+        for (int q = 0; q < 100; q++) {
+            int l = randint(0, n), r = randint(0, n);
+            if (l > r) std::swap(l, r);
+            ull sum = 0;
+            atcoder::modint998244353 sum_modint = 0;
+            for (auto& u : updates) {
+                if (l <= u.first && u.first < r) sum += u.second, sum_modint += u.second;
+            }
+            ASSERT_EQ(sum, fw.sum(l, r));
+            ASSERT_EQ(sum_modint, fw_modint.sum(l, r));
+        }
+    }
+}
+
+TEST(FenwickTreesTest, PaddedBound) {
+    amylase::padded_fenwick_tree<int> fw(10);
+    fw.add(3, std::numeric_limits<int>::max());
+    fw.add(5, std::numeric_limits<int>::min());
+    ASSERT_EQ(-1, fw.sum(0, 10));
+    ASSERT_EQ(std::numeric_limits<int>::max(), fw.sum(3, 4));
+    ASSERT_EQ(std::numeric_limits<int>::min(), fw.sum(4, 10));
+}
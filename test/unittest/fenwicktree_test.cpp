@@ -102,6 +102,46 @@ TEST(FenwickTreeTest, MintTest) {
     }
 }
 
+TEST(FenwickTreeTest, VectorConstructor) {
+    for (int n = 0; n <= 50; n++) {
+        std::vector<ll> a(n);
+        for (int i = 0; i < n; i++) a[i] = i * i - 7 * i;
+        fenwick_tree<ll> fw(a);
+        for (int l = 0; l <= n; l++) {
+            for (int r = l; r <= n; r++) {
+                ll sum = 0;
+                for (int i = l; i < r; i++) {
+                    sum += a[i];
+                }
+                ASSERT_EQ(sum, fw.sum(l, r));
+            }
+        }
+    }
+}
+
+TEST(FenwickTreeTest, LowerBound) {
+    for (int n = 0; n <= 50; n++) {
+        std::vector<ll> a(n);
+        for (int i = 0; i < n; i++) a[i] = i % 3;
+        fenwick_tree<ll> fw(a);
+        ll total = std::accumulate(a.begin(), a.end(), 0LL);
+        for (ll w = -1; w <= total + 1; w++) {
+            int expected = 0;
+            ll sum = 0;
+            while (expected < n && sum + a[expected] < w) sum += a[expected++];
+            ASSERT_EQ(expected, fw.lower_bound(w));
+        }
+    }
+}
+
+TEST(FenwickTreeTest, LowerBoundUnsigned) {
+    fenwick_tree<ull> fw(std::vector<ull>{1ULL << 62, 1ULL << 62, 1ULL << 62});
+    ASSERT_EQ(0, fw.lower_bound(0));
+    ASSERT_EQ(1, fw.lower_bound((1ULL << 62) + 1));
+    ASSERT_EQ(2, fw.lower_bound(3ULL << 62));
+    ASSERT_EQ(3, fw.lower_bound((3ULL << 62) + 1));
+}
+
 TEST(FenwickTreeTest, Invalid) {
     EXPECT_THROW(auto s = fenwick_tree<int>(-1), std::exception);
     fenwick_tree<int> s(10);
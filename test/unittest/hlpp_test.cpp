@@ -0,0 +1,180 @@
+#include <amylase/hlpp>
+
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include <atcoder/maxflow>
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+using namespace amylase;
+
+template <class edge> void edge_eq(edge expect, edge actual) {
+    ASSERT_EQ(expect.from, actual.from);
+    ASSERT_EQ(expect.to, actual.to);
+    ASSERT_EQ(expect.cap, actual.cap);
+    ASSERT_EQ(expect.flow, actual.flow);
+}
+
+TEST(HLPPTest, Zero) {
+    hlpp_graph<int> g1;
+    hlpp_graph<int> g2(0);
+    g1 = hlpp_graph<int>(10);
+}
+
+TEST(HLPPTest, Simple) {
+    hlpp_graph<int> g(4);
+    ASSERT_EQ(0, g.add_edge(0, 1, 1));
+    ASSERT_EQ(1, g.add_edge(0, 2, 1));
+    ASSERT_EQ(2, g.add_edge(1, 3, 1));
+    ASSERT_EQ(3, g.add_edge(2, 3, 1));
+    ASSERT_EQ(4, g.add_edge(1, 2, 1));
+    ASSERT_EQ(2, g.flow(0, 3));
+
+    hlpp_graph<int>::edge e;
+    e = {0, 1, 1, 1};
+    edge_eq(e, g.get_edge(0));
+    e = {0, 2, 1, 1};
+    edge_eq(e, g.get_edge(1));
+    e = {1, 3, 1, 1};
+    edge_eq(e, g.get_edge(2));
+    e = {2, 3, 1, 1};
+    edge_eq(e, g.get_edge(3));
+    e = {1, 2, 1, 0};
+    edge_eq(e, g.get_edge(4));
+
+    ASSERT_EQ((std::vector<bool>{true, false, false, false}), g.min_cut(0));
+}
+
+TEST(HLPPTest, Twice) {
+    hlpp_graph<int>::edge e;
+
+    hlpp_graph<int> g(3);
+    ASSERT_EQ(0, g.add_edge(0, 1, 1));
+    ASSERT_EQ(1, g.add_edge(0, 2, 1));
+    ASSERT_EQ(2, g.add_edge(1, 2, 1));
+
+    ASSERT_EQ(2, g.flow(0, 2));
+
+    g.change_edge(0, 100, 10);
+    e = {0, 1, 100, 10};
+    edge_eq(e, g.get_edge(0));
+
+    ASSERT_EQ(0, g.flow(0, 2));
+    ASSERT_EQ(90, g.flow(0, 1));
+
+    e = {0, 1, 100, 100};
+    edge_eq(e, g.get_edge(0));
+    e = {0, 2, 1, 1};
+    edge_eq(e, g.get_edge(1));
+    e = {1, 2, 1, 1};
+    edge_eq(e, g.get_edge(2));
+
+    ASSERT_EQ(2, g.flow(2, 0));
+
+    // adding an edge after a flow keeps the flows of the others
+    ASSERT_EQ(3, g.add_edge(2, 1, 5));
+    e = {0, 1, 100, 99};
+    edge_eq(e, g.get_edge(0));
+    e = {0, 2, 1, 0};
+    edge_eq(e, g.get_edge(1));
+    e = {1, 2, 1, 0};
+    edge_eq(e, g.get_edge(2));
+    ASSERT_EQ(5, g.flow(2, 0));
+}
+
+TEST(HLPPTest, Bound) {
+    const unsigned int INF = std::numeric_limits<unsigned int>::max();
+    hlpp_graph<unsigned int> g(3);
+    ASSERT_EQ(0, g.add_edge(0, 1, INF));
+    ASSERT_EQ(1, g.add_edge(1, 0, INF));
+    ASSERT_EQ(2, g.add_edge(0, 2, INF));
+
+    ASSERT_EQ(INF, g.flow(0, 2));
+
+    hlpp_graph<unsigned int>::edge e;
+    e = {0, 1, INF, 0};
+    edge_eq(e, g.get_edge(0));
+    e = {1, 0, INF, 0};
+    edge_eq(e, g.get_edge(1));
+    e = {0, 2, INF, INF};
+    edge_eq(e, g.get_edge(2));
+}
+
+TEST(HLPPTest, SelfLoop) {
+    hlpp_graph<int> g(3);
+    ASSERT_EQ(0, g.add_edge(0, 0, 100));
+    ASSERT_EQ(1, g.add_edge(0, 1, 10));
+    ASSERT_EQ(10, g.flow(0, 1));
+    hlpp_graph<int>::edge e = {0, 0, 100, 0};
+    edge_eq(e, g.get_edge(0));
+}
+
+TEST(HLPPTest, Stress) {
+    for (int phase = 0; phase < 5000; phase++) {
+        int n = randint(2, 20);
+        int m = randint(1, 100);
+        hlpp_graph<int> g(n);
+        atcoder::mf_graph<int> expected(n);
+        for (int i = 0; i < m; i++) {
+            int u = randint(0, n - 1);
+            int v = randint(0, n - 1);
+            int c = randint(0, 10000);
+            g.add_edge(u, v, c);
+            expected.add_edge(u, v, c);
+        }
+        // a few flows on the same graph, some of them limited
+        for (int k = 0; k < 3; k++) {
+            int s, t;
+            std::tie(s, t) = randpair(0, n - 1);
+            if (randbool()) std::swap(s, t);
+            int limit = randbool() ? std::numeric_limits<int>::max() : randint(0, 20000);
+            int flow = g.flow(s, t, limit);
+            ASSERT_EQ(expected.flow(s, t, limit), flow);
+
+            std::vector<int> v_flow(n);
+            for (auto e : g.edges()) {
+                ASSERT_LE(0, e.flow);
+                ASSERT_LE(e.flow, e.cap);
+                v_flow[e.from] -= e.flow;
+                v_flow[e.to] += e.flow;
+            }
+            auto ex = expected.edges();
+            std::vector<int> w_flow(n);
+            for (auto e : ex) {
+                w_flow[e.from] -= e.flow;
+                w_flow[e.to] += e.flow;
+            }
+            ASSERT_EQ(w_flow, v_flow);
+
+            // the residual graph of a maximum flow has no path from s to t
+            if (flow < limit) {
+                auto cut = g.min_cut(s);
+                ASSERT_TRUE(cut[s]);
+                ASSERT_FALSE(cut[t]);
+            }
+        }
+    }
+}
+
+TEST(HLPPTest, Large) {
+    // dense bipartite graph: s -> left -> right -> t
+    int a = 300, b = 300;
+    int n = a + b + 2, s = a + b, t = a + b + 1;
+    hlpp_graph<long long> g(n);
+    atcoder::mf_graph<long long> expected(n);
+    auto add = [&](int u, int v, long long c) {
+        g.add_edge(u, v, c);
+        expected.add_edge(u, v, c);
+    };
+    for (int i = 0; i < a; i++) add(s, i, randint(1, 1000));
+    for (int j = 0; j < b; j++) add(a + j, t, randint(1, 1000));
+    for (int i = 0; i < a; i++) {
+        for (int j = 0; j < b; j++) {
+            if (randint(0, 3) == 0) add(i, a + j, randint(1, 100));
+        }
+    }
+    ASSERT_EQ(expected.flow(s, t), g.flow(s, t));
+}
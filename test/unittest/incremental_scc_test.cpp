@@ -0,0 +1,163 @@
+#include <amylase/incremental_scc>
+#include <atcoder/scc>
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+namespace {
+
+// component id of each vertex by atcoder::scc_graph
+std::vector<int> scc_ids(int n, const std::vector<std::pair<int, int>>& edges) {
+    atcoder::scc_graph g(n);
+    for (auto e : edges) g.add_edge(e.first, e.second);
+    std::vector<int> ids(n);
+    auto scc = g.scc();
+    for (int i = 0; i < int(scc.size()); i++) {
+        for (int v : scc[i]) ids[v] = i;
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST(IncrementalSCCTest, Simple) {
+    amylase::incremental_scc g(4);
+    ASSERT_FALSE(g.add_edge(0, 1));
+    ASSERT_FALSE(g.add_edge(1, 2));
+    ASSERT_FALSE(g.add_edge(3, 0));
+    ASSERT_EQ(4, g.components());
+    ASSERT_TRUE(g.add_edge(2, 0));
+    ASSERT_EQ(2, g.components());
+    ASSERT_TRUE(g.same(0, 2));
+    ASSERT_FALSE(g.same(0, 3));
+    ASSERT_EQ(3, g.size(1));
+    ASSERT_FALSE(g.add_edge(1, 0));
+    ASSERT_EQ(std::vector<std::vector<int>>({{3}, {0, 1, 2}}), g.scc());
+    ASSERT_TRUE(g.add_edge(2, 3));
+    ASSERT_EQ(std::vector<std::vector<int>>({{0, 1, 2, 3}}), g.scc());
+}
+
+TEST(IncrementalSCCTest, Naive) {
+    for (int ph = 0; ph < 200; ph++) {
+        int n = randint(1, 20);
+        int m = randint(0, 3 * n);
+        amylase::incremental_scc g(n);
+        std::vector<std::pair<int, int>> edges;
+        int components = n;
+        for (int i = 0; i < m; i++) {
+            int u = randint(0, n - 1), v = randint(0, n - 1);
+            edges.push_back({u, v});
+            bool merged = g.add_edge(u, v);
+            auto ids = scc_ids(n, edges);
+            int now = *std::max_element(ids.begin(), ids.end()) + 1;
+            ASSERT_EQ(now < components, merged);
+            components = now;
+            ASSERT_EQ(components, g.components());
+            for (int a = 0; a < n; a++) {
+                for (int b = 0; b < n; b++) ASSERT_EQ(ids[a] == ids[b], g.same(a, b));
+            }
+            // a topological order
+            auto scc = g.scc();
+            std::vector<int> pos(n);
+            for (int j = 0; j < int(scc.size()); j++) {
+                for (int w : scc[j]) pos[w] = j;
+            }
+            for (auto e : edges) ASSERT_LE(pos[e.first], pos[e.second]);
+        }
+    }
+}
+
+TEST(IncrementalSCCTest, Batch) {
+    for (int ph = 0; ph < 200; ph++) {
+        int n = randint(1, 20);
+        amylase::incremental_scc g(n);
+        std::vector<std::pair<int, int>> edges;
+        int components = n;
+        for (int b = 0; b < 10; b++) {
+            std::vector<std::pair<int, int>> batch(randint(0, n));
+            for (auto& e : batch) e = {randint(0, n - 1), randint(0, n - 1)};
+            bool merged;
+            if (randbool()) {
+                merged = g.add_edges(batch);
+            } else {
+                merged = false;
+                for (auto e : batch) merged |= g.add_edge(e.first, e.second);
+            }
+            edges.insert(edges.end(), batch.begin(), batch.end());
+            auto ids = scc_ids(n, edges);
+            int now = *std::max_element(ids.begin(), ids.end()) + 1;
+            ASSERT_EQ(now < components, merged);
+            components = now;
+            ASSERT_EQ(components, g.components());
+            for (int a = 0; a < n; a++) {
+                for (int c = 0; c < n; c++) ASSERT_EQ(ids[a] == ids[c], g.same(a, c));
+            }
+            auto scc = g.scc();
+            std::vector<int> pos(n);
+            for (int j = 0; j < int(scc.size()); j++) {
+                for (int w : scc[j]) pos[w] = j;
+            }
+            for (auto e : edges) ASSERT_LE(pos[e.first], pos[e.second]);
+        }
+    }
+}
+
+TEST(IncrementalSCCTest, Large) {
+    // a path closed into a cycle, step by step from the end
+    int n = 100000;
+    amylase::incremental_scc g(n);
+    for (int i = n - 2; i >= 0; i--) ASSERT_FALSE(g.add_edge(i, i + 1));
+    for (int i = n - 1; i > 0; i -= 1000) ASSERT_TRUE(g.add_edge(i, std::max(0, i - 1000)));
+    ASSERT_EQ(1, g.components());
+}
+
+TEST(OfflineIncrementalSCCTest, Naive) {
+    for (int ph = 0; ph < 200; ph++) {
+        int n = randint(1, 15);
+        int m = randint(0, 3 * n);
+        std::vector<std::pair<int, int>> edges(m);
+        for (auto& e : edges) e = {randint(0, n - 1), randint(0, n - 1)};
+        amylase::offline_incremental_scc g(n, edges);
+
+        std::vector<std::vector<int>> ids(m + 1);
+        for (int k = 0; k <= m; k++) {
+            ids[k] = scc_ids(n, std::vector<std::pair<int, int>>(edges.begin(), edges.begin() + k));
+        }
+        for (int i = 0; i < m; i++) {
+            int expected = -1;
+            for (int k = i + 1; k <= m; k++) {
+                if (ids[k][edges[i].first] == ids[k][edges[i].second]) {
+                    expected = k;
+                    break;
+                }
+            }
+            ASSERT_EQ(expected, g.edge_time(i));
+        }
+        for (int a = 0; a < n; a++) {
+            for (int b = 0; b < n; b++) {
+                int expected = -1;
+                for (int k = 0; k <= m; k++) {
+                    if (ids[k][a] == ids[k][b]) {
+                        expected = k;
+                        break;
+                    }
+                }
+                ASSERT_EQ(expected, g.pair_time(a, b));
+            }
+        }
+    }
+}
+
+TEST(OfflineIncrementalSCCTest, Large) {
+    int n = 100000;
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i + 1 < n; i++) edges.push_back({i, i + 1});
+    edges.push_back({n - 1, 0});
+    amylase::offline_incremental_scc g(n, edges);
+    for (int i = 0; i + 1 < n; i++) ASSERT_EQ(n, g.edge_time(i));
+    ASSERT_EQ(n, g.pair_time(0, n - 1));
+    ASSERT_EQ(0, g.pair_time(5, 5));
+}
@@ -0,0 +1,139 @@
+#include <amylase/li_chao_tree>
+#include "../utils/random.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using li = long long;
+
+struct naive {
+    struct segment {
+        li l, r, a, b;
+    };
+    std::vector<segment> segments;
+    void add_line(li a, li b) { add_segment(std::numeric_limits<li>::lowest(), std::numeric_limits<li>::max(), a, b); }
+    void add_segment(li l, li r, li a, li b) { segments.push_back({l, r, a, b}); }
+    li get(li x) {
+        li res = std::numeric_limits<li>::max();
+        for (auto& s : segments) {
+            if (s.l <= x && x < s.r) res = std::min(res, s.a * x + s.b);
+        }
+        return res;
+    }
+};
+
+TEST(LiChaoTreeTest, Empty) {
+    amylase::li_chao_tree<li> t;
+    t.add_line(1, 2);
+    t.add_segment(0, 10, 1, 2);
+    amylase::li_chao_tree<li> u({3});
+    ASSERT_EQ(std::numeric_limits<li>::max(), u.get(3));
+    amylase::dynamic_li_chao_tree<li> v(-10, 10);
+    ASSERT_EQ(std::numeric_limits<li>::max(), v.get(-10));
+}
+
+// the largest intercept is a line as any other, not an empty node
+TEST(LiChaoTreeTest, MaxIntercept) {
+    li inf = std::numeric_limits<li>::max();
+    amylase::li_chao_tree<li> t({1, 2, 3});
+    t.add_line(-1, inf);
+    ASSERT_EQ(inf - 2, t.get(2));
+    t.add_line(-2, inf);
+    ASSERT_EQ(inf - 6, t.get(3));
+    amylase::dynamic_li_chao_tree<li> u(0, 10);
+    u.add_segment(2, 5, -1, inf);
+    ASSERT_EQ(inf - 3, u.get(3));
+    ASSERT_EQ(inf, u.get(7));
+    u.add_line(-1, inf);
+    ASSERT_EQ(inf - 7, u.get(7));
+}
+
+TEST(LiChaoTreeTest, Naive) {
+    for (int n = 1; n <= 40; n++) {
+        std::vector<li> xs(n);
+        for (int i = 0; i < n; i++) xs[i] = randint(-1000, 1000);
+        amylase::li_chao_tree<li> t(xs);
+        amylase::dynamic_li_chao_tree<li> u(-1000, 1001);
+        naive nv;
+        for (int q = 0; q < 500; q++) {
+            int ty = randint(0, 2);
+            li a = randint(-1000, 1000), b = randint(-1'000'000, 1'000'000);
+            if (ty == 0) {
+                t.add_line(a, b);
+                u.add_line(a, b);
+                nv.add_line(a, b);
+            } else if (ty == 1) {
+                li l = randint(-1100, 1100), r = randint(-1100, 1100);
+                if (l > r) std::swap(l, r);
+                t.add_segment(l, r, a, b);
+                u.add_segment(l, r, a, b);
+                nv.add_segment(l, r, a, b);
+            } else {
+                li x = xs[randint(0, n - 1)];
+                ASSERT_EQ(nv.get(x), t.get(x));
+                ASSERT_EQ(nv.get(x), u.get(x));
+            }
+        }
+    }
+}
+
+TEST(LiChaoTreeTest, DynamicLarge) {
+    const li lo = -1'000'000'000, hi = 1'000'000'000;
+    amylase::dynamic_li_chao_tree<li> t(lo, hi);
+    t.reserve(1000);
+    naive nv;
+    for (int q = 0; q < 1000; q++) {
+        li a = randint(-1'000'000, 1'000'000), b = randint(-1'000'000'000'000LL, 1'000'000'000'000LL);
+        t.add_line(a, b);
+        nv.add_line(a, b);
+        li x = randint(lo, hi - 1);
+        ASSERT_EQ(nv.get(x), t.get(x));
+    }
+}
+
+TEST(LiChaoTreeTest, MonotoneCHT) {
+    for (int n = 1; n <= 50; n++) {
+        std::vector<std::pair<li, li>> lines(n);
+        for (auto& f : lines) f = {randint(-1'000'000, 1'000'000), randint(-1'000'000'000'000LL, 1'000'000'000'000LL)};
+        std::sort(lines.begin(), lines.end(), [](auto& f, auto& g) { return f.first > g.first; });
+        amylase::monotone_cht<li> cht, cht_monotone;
+        naive nv;
+        li x = -1'000'000;
+        for (auto& f : lines) {
+            cht.add_line(f.first, f.second);
+            cht_monotone.add_line(f.first, f.second);
+            nv.add_line(f.first, f.second);
+            li y = randint(-1'000'000, 1'000'000);
+            ASSERT_EQ(nv.get(y), cht.get(y));
+            x = std::min<li>(1'000'000, x + randint(0, 100'000));
+            ASSERT_EQ(nv.get(x), cht_monotone.get_monotone(x));
+        }
+    }
+}
+
+// lines through almost the same point, where the cross products of bad() need ~125 bits
+// (exact only with __int128)
+#ifndef _MSC_VER
+TEST(LiChaoTreeTest, MonotoneCHTNearTies) {
+    for (int phase = 0; phase < 1000; phase++) {
+        li x0 = randint(999'000, 1'000'000);
+        li v = randint(-1'000'000'000, 1'000'000'000);
+        int n = randint(3, 10);
+        std::vector<std::pair<li, li>> lines(n);
+        for (auto& f : lines) {
+            li a = randint(-9'000'000'000'000LL, 9'000'000'000'000LL);
+            f = {a, v - a * x0 + randint(-2, 2)};
+        }
+        std::sort(lines.begin(), lines.end(), [](auto& f, auto& g) { return f.first > g.first; });
+        amylase::monotone_cht<li> cht;
+        naive nv;
+        for (auto& f : lines) {
+            cht.add_line(f.first, f.second);
+            nv.add_line(f.first, f.second);
+        }
+        for (li x = x0 - 3; x <= x0 + 3; x++) ASSERT_EQ(nv.get(x), cht.get(x));
+    }
+}
+#endif
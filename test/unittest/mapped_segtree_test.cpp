@@ -0,0 +1,188 @@
+#include <amylase/mapped_segtree>
+#include <atcoder/lazysegtree>
+#include <atcoder/segtree>
+#include "../utils/random.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using li = long long;
+
+li op(li a, li b) { return std::max(a, b); }
+li e() { return -1'000'000'000'000LL; }
+li mapping(li f, li x) { return f + x; }
+li composition(li f, li g) { return f + g; }
+li id() { return 0; }
+
+using seg = amylase::mapped_segtree<li, op, e>;
+using lazy_seg = amylase::mapped_lazy_segtree<li, op, e, li, mapping, composition, id>;
+
+struct temp_file {
+    std::string path;
+    temp_file(const std::string& name) : path(name) {}
+    ~temp_file() { std::remove(path.c_str()); }
+};
+
+TEST(MappedSegtreeTest, SaveAndOpen) {
+    temp_file tmp("mapped_segtree_test_0.bin");
+    for (int n = 0; n <= 40; n++) {
+        std::vector<li> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        seg s(a);
+        ASSERT_TRUE(s.save(tmp.path));
+        seg t;
+        ASSERT_TRUE(t.open_mapped(tmp.path));
+        for (int l = 0; l <= n; l++) {
+            for (int r = l; r <= n; r++) ASSERT_EQ(s.prod(l, r), t.prod(l, r));
+        }
+        ASSERT_EQ(s.all_prod(), t.all_prod());
+        // updates after mapping are not written back
+        if (n > 0) {
+            t.set(0, 1000);
+            ASSERT_EQ(1000, t.all_prod());
+            seg u;
+            ASSERT_TRUE(u.open_mapped(tmp.path));
+            ASSERT_EQ(s.all_prod(), u.all_prod());
+            // copies own their elements
+            seg v = u;
+            v.set(n - 1, 2000);
+            ASSERT_EQ(s.all_prod(), u.all_prod());
+            ASSERT_EQ(2000, v.all_prod());
+        }
+    }
+}
+
+TEST(MappedSegtreeTest, Invalid) {
+    temp_file tmp("mapped_segtree_test_1.bin");
+    seg s(std::vector<li>{1, 2, 3});
+    ASSERT_FALSE(s.open_mapped("mapped_segtree_test_missing.bin"));
+    ASSERT_EQ(3, s.all_prod());
+
+    {
+        std::FILE* fp = std::fopen(tmp.path.c_str(), "wb");
+        std::fputs("not a snapshot, but long enough to hold a header.....", fp);
+        std::fclose(fp);
+    }
+    ASSERT_FALSE(s.open_mapped(tmp.path));
+
+    // a lazy snapshot cannot be opened as a segtree and vice versa
+    lazy_seg l(std::vector<li>{4, 5});
+    ASSERT_TRUE(l.save(tmp.path));
+    ASSERT_FALSE(s.open_mapped(tmp.path));
+    ASSERT_TRUE(s.save(tmp.path));
+    ASSERT_FALSE(l.open_mapped(tmp.path));
+    ASSERT_EQ(3, s.all_prod());
+    ASSERT_EQ(5, l.all_prod());
+
+    // offsets which wrap around when the array size is added
+    std::uint64_t wrapped = ~std::uint64_t(63);
+    for (bool lazy : {false, true}) {
+        std::vector<li> a(100, 1);
+        if (lazy) {
+            ASSERT_TRUE(lazy_seg(a).save(tmp.path));
+        } else {
+            ASSERT_TRUE(seg(a).save(tmp.path));
+        }
+        std::vector<std::size_t> fields = {offsetof(amylase::snapshot_header, d_offset)};
+        if (lazy) fields.push_back(offsetof(amylase::snapshot_header, lz_offset));
+        for (std::size_t field : fields) {
+            std::FILE* fp = std::fopen(tmp.path.c_str(), "r+b");
+            ASSERT_NE(nullptr, fp);
+            ASSERT_EQ(0, std::fseek(fp, long(field), SEEK_SET));
+            ASSERT_EQ(1u, std::fwrite(&wrapped, sizeof(wrapped), 1, fp));
+            ASSERT_EQ(0, std::fclose(fp));
+            if (lazy) {
+                ASSERT_FALSE(l.open_mapped(tmp.path));
+            } else {
+                ASSERT_FALSE(s.open_mapped(tmp.path));
+            }
+        }
+    }
+    ASSERT_EQ(3, s.all_prod());
+    ASSERT_EQ(5, l.all_prod());
+
+    // n whose 2 * size nodes overflow int
+    std::size_t huge = std::size_t(1) << 40;
+    ASSERT_TRUE(amylase::snapshot_header::make(true, 8, 8, 1 << 29, 1 << 29).valid(true, 8, 8, huge));
+    ASSERT_FALSE(amylase::snapshot_header::make(true, 8, 8, (1 << 29) + 1, 1 << 30).valid(true, 8, 8, huge));
+    ASSERT_FALSE(amylase::snapshot_header::make(true, 8, 8, 1 << 30, 1 << 30).valid(true, 8, 8, huge));
+}
+
+TEST(MappedSegtreeTest, Lazy) {
+    temp_file tmp("mapped_segtree_test_2.bin");
+    for (int n = 1; n <= 30; n++) {
+        std::vector<li> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        atcoder::lazy_segtree<li, op, e, li, mapping, composition, id> expected(a);
+        lazy_seg s(a);
+        for (int q = 0; q < 1000; q++) {
+            int ty = randint(0, 3);
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            if (ty == 0) {
+                li x = randint(-100, 100);
+                expected.apply(l, r, x);
+                s.apply(l, r, x);
+            } else if (ty == 1) {
+                ASSERT_EQ(expected.prod(l, r), s.prod(l, r));
+            } else if (ty == 2) {
+                ASSERT_EQ(expected.max_right(l, [&](li x) { return x < r; }),
+                          s.max_right(l, [&](li x) { return x < r; }));
+                ASSERT_EQ(expected.min_left(r, [&](li x) { return x < l; }),
+                          s.min_left(r, [&](li x) { return x < l; }));
+            } else {
+                ASSERT_TRUE(s.save(tmp.path));
+                lazy_seg t;
+                ASSERT_TRUE(t.open_mapped(tmp.path));
+                s = t;
+            }
+        }
+    }
+}
+
+TEST(MappedSegtreeTest, LazyOpenAndUpdate) {
+    temp_file tmp("mapped_segtree_test_3.bin");
+    for (int n = 1; n <= 30; n++) {
+        std::vector<li> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        atcoder::lazy_segtree<li, op, e, li, mapping, composition, id> expected(a);
+        lazy_seg s(a);
+        // pending lazy values are saved too
+        for (int q = 0; q < 10; q++) {
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            li x = randint(-100, 100);
+            expected.apply(l, r, x);
+            s.apply(l, r, x);
+        }
+        ASSERT_TRUE(s.save(tmp.path));
+        auto saved = expected;
+
+        // the mapped tree itself is updated, on its copy-on-write pages
+        lazy_seg t;
+        ASSERT_TRUE(t.open_mapped(tmp.path));
+        for (int q = 0; q < 1000; q++) {
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            if (randbool()) {
+                li x = randint(-100, 100);
+                expected.apply(l, r, x);
+                t.apply(l, r, x);
+            } else {
+                ASSERT_EQ(expected.prod(l, r), t.prod(l, r));
+            }
+        }
+        for (int i = 0; i < n; i++) ASSERT_EQ(expected.get(i), t.get(i));
+
+        lazy_seg u;
+        ASSERT_TRUE(u.open_mapped(tmp.path));
+        for (int l = 0; l <= n; l++) {
+            for (int r = l; r <= n; r++) ASSERT_EQ(saved.prod(l, r), u.prod(l, r));
+        }
+    }
+}
@@ -1,4 +1,6 @@
 #include <atcoder/maxflow>
+#include <amylase/csr_graph>
+#include <algorithm>
 #include <numeric>
 #include <tuple>
 #include <vector>
@@ -220,3 +222,152 @@ TEST(MaxflowTest, Stress) {
         }
     }
 }
+
+TEST(MaxflowTest, FromCSR) {
+    for (int phase = 0; phase < 1000; phase++) {
+        int n = randint(2, 20);
+        int m = randint(0, 100);
+        int s, t;
+        std::tie(s, t) = randpair(0, n - 1);
+
+        amylase::csr_graph_builder<int> builder(n);
+        for (int i = 0; i < m; i++) {
+            builder.add_edge(randint(0, n - 1), randint(0, n - 1), randint(0, 10000));
+        }
+        auto csr = builder.build();
+        mf_graph<int> g(csr, [&](int i) { return csr.payload(i); });
+        mf_graph<int> h(n);
+        for (int v = 0; v < n; v++) {
+            for (int i = csr.begin(v); i < csr.end(v); i++) {
+                ASSERT_EQ(i, h.add_edge(v, csr.to(i), csr.payload(i)));
+            }
+        }
+        ASSERT_EQ(h.flow(s, t), g.flow(s, t));
+        ASSERT_EQ(m, int(g.edges().size()));
+        for (int i = 0; i < m; i++) edge_eq(h.get_edge(i), g.get_edge(i));
+    }
+}
+
+TEST(MaxflowTest, AddAfterFlow) {
+    mf_graph<int>::edge e;
+
+    mf_graph<int> g(4);
+    ASSERT_EQ(0, g.add_edge(0, 1, 3));
+    ASSERT_EQ(1, g.add_edge(1, 3, 2));
+    ASSERT_EQ(2, g.flow(0, 3));
+    ASSERT_EQ(2, g.add_edge(1, 2, 5));
+    ASSERT_EQ(3, g.add_edge(2, 3, 5));
+    e = {0, 1, 3, 2};
+    edge_eq(e, g.get_edge(0));
+    e = {1, 3, 2, 2};
+    edge_eq(e, g.get_edge(1));
+    ASSERT_EQ(1, g.flow(0, 3));
+    e = {0, 1, 3, 3};
+    edge_eq(e, g.get_edge(0));
+    e = {1, 2, 5, 1};
+    edge_eq(e, g.get_edge(2));
+    e = {2, 3, 5, 1};
+    edge_eq(e, g.get_edge(3));
+}
+
+TEST(MaxflowTest, Freeze) {
+    for (int phase = 0; phase < 3000; phase++) {
+        int n = randint(2, 10);
+        int m = randint(1, 30);
+        int s, t;
+        std::tie(s, t) = randpair(0, n - 1);
+        mf_graph<int> g(n), h(n);
+        auto add = [&]() {
+            int u = randint(0, n - 1), v = randint(0, n - 1), c = randint(0, 100);
+            ASSERT_EQ(g.add_edge(u, v, c), h.add_edge(u, v, c));
+        };
+        for (int i = 0; i < m; i++) add();
+        for (int step = 0; step < 3; step++) {
+            if (randbool()) h.freeze();
+            int limit = randint(0, 200);
+            ASSERT_EQ(g.flow(s, t, limit), h.flow(s, t, limit));
+            if (randbool()) h.freeze();
+            ASSERT_EQ(g.min_cut(s), h.min_cut(s));
+            auto eg = g.edges(), eh = h.edges();
+            for (int i = 0; i < int(eg.size()); i++) edge_eq(eg[i], eh[i]);
+            int i = randint(0, int(eg.size()) - 1);
+            int c = randint(0, 100), f = randint(0, c);
+            g.change_edge(i, c, f);
+            h.change_edge(i, c, f);
+            for (int j = randint(0, 3); j > 0; j--) add();
+        }
+    }
+}
+
+TEST(MaxflowTest, Deep) {
+    // the augmenting path has 10^6 edges
+    int n = 1'000'000;
+    mf_graph<int> g(n);
+    for (int i = 0; i + 1 < n; i++) g.add_edge(i, i + 1, randint(1, 1000));
+    g.freeze();
+    int expect = 1000;
+    for (auto e : g.edges()) expect = std::min(expect, e.cap);
+    ASSERT_EQ(expect, g.flow(0, n - 1));
+}
+
+TEST(MaxflowTest, Reflow) {
+    for (int phase = 0; phase < 3000; phase++) {
+        int n = randint(2, 15);
+        int m = randint(1, 60);
+        int s, t;
+        std::tie(s, t) = randpair(0, n - 1);
+        if (randbool()) std::swap(s, t);
+
+        mf_graph<int> g(n);
+        std::vector<std::tuple<int, int, int>> es;
+        auto add = [&]() {
+            int u = randint(0, n - 1), v = randint(0, n - 1), c = randint(0, 100);
+            g.add_edge(u, v, c);
+            es.emplace_back(u, v, c);
+        };
+        for (int i = 0; i < m; i++) add();
+        g.flow(s, t);
+        for (int step = 0; step < 5; step++) {
+            for (int k = randint(0, 4); k > 0; k--) {
+                if (randint(0, 3) == 0) {
+                    add();
+                } else if (randint(0, 4) == 0) {
+                    // a self-loop carrying flow, whose capacity is then lowered
+                    int v = randint(0, n - 1);
+                    int c = randint(1, 100);
+                    g.add_edge(v, v, c);
+                    g.change_edge(int(es.size()), c, c);
+                    es.emplace_back(v, v, c);
+                    c = randint(0, c - 1);
+                    g.change_capacity(int(es.size()) - 1, c);
+                    std::get<2>(es.back()) = c;
+                } else {
+                    int i = randint(0, int(es.size()) - 1);
+                    int c = randint(0, 100);
+                    g.change_capacity(i, c);
+                    std::get<2>(es[i]) = c;
+                }
+            }
+            mf_graph<int> expected(n);
+            for (auto e : es) expected.add_edge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+            int flow = g.reflow(s, t);
+            ASSERT_EQ(expected.flow(s, t), flow);
+
+            std::vector<int> v_flow(n);
+            for (int i = 0; i < int(es.size()); i++) {
+                auto e = g.get_edge(i);
+                ASSERT_EQ(std::get<2>(es[i]), e.cap);
+                ASSERT_LE(0, e.flow);
+                ASSERT_LE(e.flow, e.cap);
+                v_flow[e.from] -= e.flow;
+                v_flow[e.to] += e.flow;
+            }
+            ASSERT_EQ(-flow, v_flow[s]);
+            ASSERT_EQ(flow, v_flow[t]);
+            for (int i = 0; i < n; i++) {
+                if (i == s || i == t) continue;
+                ASSERT_EQ(0, v_flow[i]);
+            }
+        }
+    }
+}
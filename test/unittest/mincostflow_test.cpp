@@ -1,7 +1,9 @@
 #include <atcoder/mincostflow>
+#include <amylase/csr_graph>
 #include <numeric>
 #include <tuple>
 #include <vector>
+#include "../utils/random.hpp"
 
 #include <gtest/gtest.h>
 
@@ -89,6 +91,35 @@ TEST(MincostflowTest, SameCostPaths) {
     ASSERT_EQ(expected, g.slope(0, 2));
 }
 
+TEST(MincostflowTest, FromCSR) {
+    struct arc {
+        int cap, cost;
+    };
+    for (int phase = 0; phase < 1000; phase++) {
+        int n = randint(2, 20);
+        int m = randint(0, 100);
+        int s, t;
+        std::tie(s, t) = randpair(0, n - 1);
+
+        amylase::csr_graph_builder<arc> builder(n);
+        for (int i = 0; i < m; i++) {
+            builder.add_edge(randint(0, n - 1), randint(0, n - 1), {randint(0, 100), randint(0, 100)});
+        }
+        auto csr = builder.build();
+        mcf_graph<int, int> g(csr, [&](int i) { return csr.payload(i).cap; },
+                              [&](int i) { return csr.payload(i).cost; });
+        mcf_graph<int, int> h(n);
+        for (int v = 0; v < n; v++) {
+            for (int i = csr.begin(v); i < csr.end(v); i++) {
+                ASSERT_EQ(i, h.add_edge(v, csr.to(i), csr.payload(i).cap, csr.payload(i).cost));
+            }
+        }
+        ASSERT_EQ(h.slope(s, t), g.slope(s, t));
+        ASSERT_EQ(m, int(g.edges().size()));
+        for (int i = 0; i < m; i++) edge_eq(h.get_edge(i), g.get_edge(i));
+    }
+}
+
 TEST(MincostflowTest, Invalid) {
     mcf_graph<int, int> g(2);
     // https://github.com/atcoder/ac-library/issues/51
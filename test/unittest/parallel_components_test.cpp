@@ -0,0 +1,79 @@
+#include <amylase/parallel_components>
+#include <atcoder/dsu>
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+namespace {
+
+std::vector<std::vector<int>> expected_groups(int n, const std::vector<std::pair<int, int>>& edges) {
+    atcoder::dsu uf(n);
+    for (auto e : edges) uf.merge(e.first, e.second);
+    auto g = uf.groups();
+    std::sort(g.begin(), g.end());
+    return g;
+}
+
+// both directions of each edge
+std::pair<std::vector<int>, std::vector<int>> to_csr(int n, const std::vector<std::pair<int, int>>& edges) {
+    std::vector<std::vector<int>> g(n);
+    for (auto e : edges) {
+        g[e.first].push_back(e.second);
+        g[e.second].push_back(e.first);
+    }
+    std::vector<int> start(1, 0), elist;
+    for (int v = 0; v < n; v++) {
+        for (int u : g[v]) elist.push_back(u);
+        start.push_back(int(elist.size()));
+    }
+    return {start, elist};
+}
+
+}  // namespace
+
+TEST(ParallelComponentsTest, Empty) {
+    ASSERT_EQ(std::vector<int>(), amylase::parallel_components(0, {}));
+    ASSERT_EQ(std::vector<int>(), amylase::parallel_components(std::vector<int>{0}, {}));
+    ASSERT_EQ(std::vector<int>({0, 1, 2}), amylase::parallel_components(3, {}));
+}
+
+TEST(ParallelComponentsTest, Simple) {
+    std::vector<std::pair<int, int>> edges = {{3, 1}, {2, 4}, {4, 4}};
+    auto ids = amylase::parallel_components(5, edges, 2);
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 1, 2}), ids);
+    ASSERT_EQ(std::vector<std::vector<int>>({{0}, {1, 3}, {2, 4}}), amylase::components_to_groups(ids));
+    auto csr = to_csr(5, edges);
+    ASSERT_EQ(ids, amylase::parallel_components(csr.first, csr.second, 2));
+}
+
+TEST(ParallelComponentsTest, Random) {
+    for (int ph = 0; ph < 300; ph++) {
+        int n = randint(1, 200);
+        int m = randint(0, 2 * n);
+        std::vector<std::pair<int, int>> edges(m);
+        for (auto& e : edges) e = {randint(0, n - 1), randint(0, n - 1)};
+        auto expected = expected_groups(n, edges);
+        int threads = randint(1, 4);
+        ASSERT_EQ(expected, amylase::components_to_groups(amylase::parallel_components(n, edges, threads)));
+        auto csr = to_csr(n, edges);
+        int rounds = randint(0, 3);
+        ASSERT_EQ(expected, amylase::components_to_groups(
+                                amylase::parallel_components(csr.first, csr.second, threads, rounds)));
+    }
+}
+
+TEST(ParallelComponentsTest, Large) {
+    // a giant component and many small ones, with enough vertices to be split among the threads
+    int n = 200000;
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < n / 2; i++) edges.push_back({randint(0, n / 2 - 1), randint(0, n / 2 - 1)});
+    for (int i = n / 2; i + 1 < n; i += 3) edges.push_back({i, i + 1});
+    std::shuffle(edges.begin(), edges.end(), global_mt19937);
+    auto expected = expected_groups(n, edges);
+    ASSERT_EQ(expected, amylase::components_to_groups(amylase::parallel_components(n, edges, 4)));
+    auto csr = to_csr(n, edges);
+    ASSERT_EQ(expected, amylase::components_to_groups(amylase::parallel_components(csr.first, csr.second, 4)));
+}
@@ -0,0 +1,97 @@
+#include <amylase/parallel_scc>
+#include <atcoder/scc>
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+namespace {
+
+// checks that groups is a topological order of the components expected
+void check(int n,
+           const std::vector<std::pair<int, int>>& edges,
+           const std::vector<std::vector<int>>& groups,
+           std::vector<std::vector<int>> expected) {
+    std::vector<int> id(n, -1);
+    for (int i = 0; i < int(groups.size()); i++) {
+        ASSERT_TRUE(std::is_sorted(groups[i].begin(), groups[i].end()));
+        for (int v : groups[i]) id[v] = i;
+    }
+    for (auto e : edges) ASSERT_LE(id[e.first], id[e.second]);
+    auto sorted = groups;
+    std::sort(sorted.begin(), sorted.end());
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, sorted);
+}
+
+void test(int n, const std::vector<std::pair<int, int>>& edges, int threads) {
+    atcoder::scc_graph g(n);
+    amylase::parallel_scc_graph pg(n);
+    for (auto e : edges) {
+        g.add_edge(e.first, e.second);
+        pg.add_edge(e.first, e.second);
+    }
+    auto groups = pg.scc(threads);
+    check(n, edges, groups, g.scc());
+    // the result does not depend on the number of threads
+    ASSERT_EQ(groups, pg.scc(1));
+}
+
+}  // namespace
+
+TEST(ParallelSCCTest, Empty) {
+    amylase::parallel_scc_graph g0;
+    ASSERT_EQ(std::vector<std::vector<int>>(), g0.scc());
+    amylase::parallel_scc_graph g1(0);
+    ASSERT_EQ(std::vector<std::vector<int>>(), g1.scc(2));
+}
+
+TEST(ParallelSCCTest, Simple) {
+    amylase::parallel_scc_graph g(4);
+    g.add_edge(3, 0);
+    g.add_edge(0, 1);
+    g.add_edge(1, 0);
+    g.add_edge(2, 2);
+    auto scc = g.scc(2);
+    ASSERT_EQ(3, int(scc.size()));
+    check(4, {{3, 0}, {0, 1}, {1, 0}, {2, 2}}, scc, {{0, 1}, {2}, {3}});
+}
+
+TEST(ParallelSCCTest, Random) {
+    for (int ph = 0; ph < 300; ph++) {
+        int n = randint(1, 50);
+        int m = randint(0, 3 * n);
+        std::vector<std::pair<int, int>> edges(m);
+        for (auto& e : edges) e = {randint(0, n - 1), randint(0, n - 1)};
+        test(n, edges, randint(1, 4));
+    }
+}
+
+TEST(ParallelSCCTest, Large) {
+    // large enough to go through forward-backward search and coloring
+    for (int kind = 0; kind < 3; kind++) {
+        int n = 30000;
+        std::vector<std::pair<int, int>> edges;
+        if (kind == 0) {
+            // sparse random graph: a giant component, trees around it
+            for (int i = 0; i < n + n / 2; i++) edges.push_back({randint(0, n - 1), randint(0, n - 1)});
+        } else if (kind == 1) {
+            // many middle-sized cycles, connected forward
+            for (int i = 0; i < n; i++) {
+                int next = i % 10 == 9 ? i - 9 : i + 1;
+                edges.push_back({i, next});
+                if (i + 10 < n && randint(0, 3) == 0) edges.push_back({i, randint(i + 10, n - 1)});
+            }
+        } else {
+            // a long chain of 2-cycles going to smaller ids
+            for (int i = 0; i + 1 < n; i += 2) {
+                edges.push_back({i, i + 1});
+                edges.push_back({i + 1, i});
+                if (i >= 2) edges.push_back({i, i - 1});
+            }
+        }
+        test(n, edges, 4);
+    }
+}
@@ -0,0 +1,100 @@
+#include <amylase/reachability>
+
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+using namespace amylase;
+
+namespace {
+
+std::vector<std::vector<bool>> naive_closure(int n, const std::vector<std::pair<int, int>>& edges) {
+    std::vector<std::vector<int>> g(n);
+    for (auto e : edges) g[e.first].push_back(e.second);
+    std::vector<std::vector<bool>> reach(n, std::vector<bool>(n));
+    for (int s = 0; s < n; s++) {
+        std::queue<int> que;
+        reach[s][s] = true;
+        que.push(s);
+        while (!que.empty()) {
+            int v = que.front();
+            que.pop();
+            for (int to : g[v]) {
+                if (reach[s][to]) continue;
+                reach[s][to] = true;
+                que.push(to);
+            }
+        }
+    }
+    return reach;
+}
+
+}  // namespace
+
+TEST(ReachabilityTest, Empty) {
+    atcoder::scc_graph g(0);
+    reachability_index index(g);
+    ASSERT_EQ(std::vector<bool>(), offline_reachability(g.condensation(), {}));
+}
+
+TEST(ReachabilityTest, Simple) {
+    atcoder::scc_graph g(4);
+    g.add_edge(0, 1);
+    g.add_edge(1, 0);
+    g.add_edge(1, 2);
+    reachability_index index(g);
+    ASSERT_TRUE(index.reachable(0, 0));
+    ASSERT_TRUE(index.reachable(1, 0));
+    ASSERT_TRUE(index.reachable(0, 2));
+    ASSERT_FALSE(index.reachable(2, 0));
+    ASSERT_FALSE(index.reachable(0, 3));
+    ASSERT_TRUE(index.reachable(3, 3));
+}
+
+TEST(ReachabilityTest, Naive) {
+    for (int ph = 0; ph < 300; ph++) {
+        int n = randint(1, 200);
+        int m = randint(0, 2 * n);
+        atcoder::scc_graph g(n);
+        std::vector<std::pair<int, int>> edges(m);
+        for (auto& e : edges) {
+            e = {randint(0, n - 1), randint(0, n - 1)};
+            g.add_edge(e.first, e.second);
+        }
+        auto reach = naive_closure(n, edges);
+        reachability_index index(g);
+        std::vector<std::pair<int, int>> queries;
+        for (int u = 0; u < n; u++) {
+            for (int v = 0; v < n; v++) {
+                ASSERT_EQ(reach[u][v], index.reachable(u, v));
+                queries.push_back({u, v});
+            }
+        }
+        auto result = offline_reachability(g.condensation(), queries, randint(1, 3));
+        for (int i = 0; i < int(queries.size()); i++) {
+            ASSERT_EQ(reach[queries[i].first][queries[i].second], result[i]);
+        }
+    }
+}
+
+TEST(ReachabilityTest, Large) {
+    // a path of 20000 vertices: the closure is the upper triangle
+    int n = 20000;
+    atcoder::scc_graph g(n);
+    for (int i = 0; i + 1 < n; i++) g.add_edge(i, i + 1);
+    reachability_index index(g);
+    std::vector<std::pair<int, int>> queries;
+    for (int ph = 0; ph < 100000; ph++) {
+        int u = randint(0, n - 1), v = randint(0, n - 1);
+        ASSERT_EQ(u <= v, index.reachable(u, v));
+        queries.push_back({u, v});
+    }
+    auto result = offline_reachability(g.condensation(), queries, 64);
+    for (int i = 0; i < int(queries.size()); i++) {
+        ASSERT_EQ(queries[i].first <= queries[i].second, result[i]);
+    }
+}
@@ -0,0 +1,145 @@
+#include <amylase/rollback_dsu>
+#include <atcoder/dsu>
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+TEST(RollbackDSUTest, Simple) {
+    amylase::rollback_dsu uf(4);
+    ASSERT_EQ(4, uf.components());
+    int s0 = uf.snapshot();
+    uf.merge(0, 1);
+    int s1 = uf.snapshot();
+    uf.merge(2, 3);
+    uf.merge(1, 0);
+    ASSERT_EQ(2, uf.components());
+    uf.merge(1, 3);
+    ASSERT_EQ(4, uf.size(2));
+    ASSERT_EQ(1, uf.components());
+    uf.undo();
+    ASSERT_FALSE(uf.same(0, 3));
+    ASSERT_EQ(2, uf.size(3));
+    uf.rollback(s1);
+    ASSERT_TRUE(uf.same(0, 1));
+    ASSERT_FALSE(uf.same(2, 3));
+    ASSERT_EQ(3, uf.components());
+    uf.rollback(s0);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(i, uf.leader(i));
+        ASSERT_EQ(1, uf.size(i));
+    }
+}
+
+TEST(RollbackDSUTest, Naive) {
+    for (int n = 1; n <= 20; n++) {
+        amylase::rollback_dsu uf(n);
+        std::vector<std::pair<int, int>> merged;
+        for (int ph = 0; ph < 200; ph++) {
+            int type = randint(0, 2);
+            if (type == 0 || merged.empty()) {
+                int a = randint(0, n - 1), b = randint(0, n - 1);
+                uf.merge(a, b);
+                merged.push_back({a, b});
+            } else if (type == 1) {
+                int k = randint(0, int(merged.size()));
+                uf.rollback(k);
+                merged.resize(k);
+            } else {
+                uf.undo();
+                merged.pop_back();
+            }
+            atcoder::dsu expected(n);
+            for (auto e : merged) expected.merge(e.first, e.second);
+            ASSERT_EQ(int(expected.groups().size()), uf.components());
+            for (int i = 0; i < n; i++) {
+                ASSERT_EQ(expected.size(i), uf.size(i));
+                for (int j = 0; j < n; j++) ASSERT_EQ(expected.same(i, j), uf.same(i, j));
+            }
+        }
+    }
+}
+
+TEST(OfflineDynamicConnectivityTest, Empty) {
+    amylase::offline_dynamic_connectivity dc(3);
+    ASSERT_EQ(std::vector<bool>(), dc.solve());
+    dc.add_edge(0, 1);
+    ASSERT_EQ(std::vector<bool>(), dc.solve());
+}
+
+TEST(OfflineDynamicConnectivityTest, Simple) {
+    amylase::offline_dynamic_connectivity dc(3);
+    dc.add_query(0, 1);
+    dc.add_edge(0, 1);
+    dc.add_edge(1, 0);
+    dc.add_query(0, 1);
+    dc.remove_edge(0, 1);
+    dc.add_query(1, 0);
+    dc.remove_edge(1, 0);
+    dc.add_query(0, 1);
+    dc.add_query(2, 2);
+    ASSERT_EQ(std::vector<bool>({false, true, true, false, true}), dc.solve());
+}
+
+TEST(OfflineDynamicConnectivityTest, Naive) {
+    for (int n = 1; n <= 10; n++) {
+        for (int ph = 0; ph < 20; ph++) {
+            amylase::offline_dynamic_connectivity dc(n);
+            std::vector<std::pair<int, int>> graph;
+            std::vector<bool> expected;
+            std::vector<int> expected_components;
+            int events = randint(0, 100);
+            for (int i = 0; i < events; i++) {
+                int type = randint(0, 2);
+                if (type == 0) {
+                    int u = randint(0, n - 1), v = randint(0, n - 1);
+                    dc.add_edge(u, v);
+                    graph.push_back({std::min(u, v), std::max(u, v)});
+                } else if (type == 1 && !graph.empty()) {
+                    int k = randint(0, int(graph.size()) - 1);
+                    std::swap(graph[k], graph.back());
+                    if (randbool()) {
+                        dc.remove_edge(graph.back().first, graph.back().second);
+                    } else {
+                        dc.remove_edge(graph.back().second, graph.back().first);
+                    }
+                    graph.pop_back();
+                } else {
+                    int u = randint(0, n - 1), v = randint(0, n - 1);
+                    ASSERT_EQ(int(expected.size()), dc.add_query(u, v));
+                    atcoder::dsu uf(n);
+                    for (auto e : graph) uf.merge(e.first, e.second);
+                    expected.push_back(uf.same(u, v));
+                    expected_components.push_back(int(uf.groups().size()));
+                }
+            }
+            ASSERT_EQ(expected, dc.solve());
+            int next = 0;
+            dc.solve([&](int i, const amylase::rollback_dsu& uf) {
+                ASSERT_EQ(next++, i);
+                ASSERT_EQ(expected_components[i], uf.components());
+            });
+            ASSERT_EQ(int(expected.size()), next);
+        }
+    }
+}
+
+TEST(OfflineDynamicConnectivityTest, Large) {
+    // a path which loses and regains one edge per query
+    int n = 100000;
+    amylase::offline_dynamic_connectivity dc(n);
+    for (int i = 0; i < n - 1; i++) dc.add_edge(i, i + 1);
+    for (int i = 0; i < n - 1; i++) {
+        dc.remove_edge(i + 1, i);
+        dc.add_query(0, n - 1);
+        dc.add_query(0, i);
+        dc.add_edge(i, i + 1);
+    }
+    auto result = dc.solve();
+    for (int i = 0; i < n - 1; i++) {
+        ASSERT_FALSE(result[2 * i]);
+        ASSERT_TRUE(result[2 * i + 1]);
+    }
+}
@@ -1,13 +1,56 @@
 #include <atcoder/scc>
 #include <atcoder/modint>
 #include <numeric>
+#include <algorithm>
 
 #include <gtest/gtest.h>
 
+#include "../utils/random.hpp"
+
 using namespace atcoder;
 using ll = long long;
 using ull = unsigned long long;
 
+namespace {
+
+// the former recursive implementation, which scc() must match exactly
+std::vector<std::vector<int>> recursive_scc(int n, const std::vector<std::pair<int, int>>& edges) {
+    std::vector<std::vector<int>> g(n);
+    for (auto e : edges) g[e.first].push_back(e.second);
+    int now_ord = 0, group_num = 0;
+    std::vector<int> visited, low(n), ord(n, -1), ids(n);
+    auto dfs = [&](auto self, int v) -> void {
+        low[v] = ord[v] = now_ord++;
+        visited.push_back(v);
+        for (int to : g[v]) {
+            if (ord[to] == -1) {
+                self(self, to);
+                low[v] = std::min(low[v], low[to]);
+            } else {
+                low[v] = std::min(low[v], ord[to]);
+            }
+        }
+        if (low[v] == ord[v]) {
+            while (true) {
+                int u = visited.back();
+                visited.pop_back();
+                ord[u] = n;
+                ids[u] = group_num;
+                if (u == v) break;
+            }
+            group_num++;
+        }
+    };
+    for (int i = 0; i < n; i++) {
+        if (ord[i] == -1) dfs(dfs, i);
+    }
+    std::vector<std::vector<int>> groups(group_num);
+    for (int i = 0; i < n; i++) groups[group_num - 1 - ids[i]].push_back(i);
+    return groups;
+}
+
+}  // namespace
+
 TEST(SCCTest, Empty) {
     scc_graph graph0;
     ASSERT_EQ(std::vector<std::vector<int>>(), graph0.scc());
@@ -41,3 +84,69 @@ TEST(SCCTest, Invalid) {
     scc_graph graph(2);
     EXPECT_DEATH(graph.add_edge(0, 10), ".*");
 }
+
+TEST(SCCTest, SameAsRecursive) {
+    for (int ph = 0; ph < 500; ph++) {
+        int n = randint(1, 30);
+        int m = randint(0, 3 * n);
+        std::vector<std::pair<int, int>> edges(m);
+        scc_graph graph(n);
+        for (auto& e : edges) {
+            e = {randint(0, n - 1), randint(0, n - 1)};
+            graph.add_edge(e.first, e.second);
+        }
+        ASSERT_EQ(recursive_scc(n, edges), graph.scc());
+    }
+}
+
+TEST(SCCTest, Deep) {
+    // deep enough to overflow the call stack with a recursive DFS
+    int n = 1000000;
+    scc_graph path(n), cycle(n);
+    for (int i = 0; i + 1 < n; i++) {
+        path.add_edge(i, i + 1);
+        cycle.add_edge(i, i + 1);
+    }
+    cycle.add_edge(n - 1, 0);
+    auto scc = path.scc();
+    ASSERT_EQ(n, int(scc.size()));
+    for (int i = 0; i < n; i++) ASSERT_EQ(std::vector<int>({i}), scc[i]);
+    ASSERT_EQ(1, int(cycle.scc().size()));
+}
+
+TEST(SCCTest, Condensation) {
+    scc_graph graph0(0);
+    auto c0 = graph0.condensation();
+    ASSERT_EQ(std::vector<int>(), c0.ids);
+    ASSERT_EQ(std::vector<int>({0}), c0.start);
+    ASSERT_EQ(std::vector<int>(), c0.elist);
+
+    for (int ph = 0; ph < 500; ph++) {
+        int n = randint(1, 30);
+        int m = randint(0, 3 * n);
+        scc_graph graph(n);
+        std::vector<std::pair<int, int>> edges(m);
+        for (auto& e : edges) {
+            e = {randint(0, n - 1), randint(0, n - 1)};
+            graph.add_edge(e.first, e.second);
+        }
+        auto scc = graph.scc();
+        auto c = graph.condensation();
+        int k = int(scc.size());
+        ASSERT_EQ(k + 1, int(c.start.size()));
+        for (int i = 0; i < k; i++) {
+            for (int v : scc[i]) ASSERT_EQ(i, c.ids[v]);
+        }
+        std::vector<std::vector<int>> expected(k);
+        for (auto e : edges) {
+            int a = c.ids[e.first], b = c.ids[e.second];
+            if (a != b) expected[a].push_back(b);
+        }
+        for (int i = 0; i < k; i++) {
+            std::sort(expected[i].begin(), expected[i].end());
+            expected[i].erase(std::unique(expected[i].begin(), expected[i].end()), expected[i].end());
+            ASSERT_EQ(expected[i], std::vector<int>(c.elist.begin() + c.start[i], c.elist.begin() + c.start[i + 1]));
+            for (int j = c.start[i]; j < c.start[i + 1]; j++) ASSERT_LT(i, c.elist[j]);
+        }
+    }
+}
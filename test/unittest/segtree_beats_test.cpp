@@ -0,0 +1,96 @@
+#include <amylase/segtrees>
+#include "../utils/random.hpp"
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using li = long long;
+using node = amylase::beats_node<li>;
+using action = amylase::beats_action<li>;
+using seg = amylase::sum_beats_segtree<li>;
+
+TEST(SegtreeBeatsTest, Zero) {
+    seg s(0);
+    ASSERT_EQ(0, s.all_prod().sum);
+    seg t(10);
+    ASSERT_EQ(0, t.all_prod().sum);
+}
+
+TEST(SegtreeBeatsTest, Simple) {
+    seg s(amylase::beats_nodes<li>({1, 5, 3, 9, 2}));
+    s.apply(0, 5, action::chmin(4));
+    ASSERT_EQ(1 + 4 + 3 + 4 + 2, s.all_prod().sum);
+    s.apply(1, 4, action::chmax(4));
+    ASSERT_EQ(1 + 4 + 4 + 4 + 2, s.all_prod().sum);
+    s.apply(2, 5, action::plus(10));
+    ASSERT_EQ(14, s.get(2).sum);
+    ASSERT_EQ(14, s.prod(1, 4).max1);
+    ASSERT_EQ(4, s.prod(1, 4).min1);
+    ASSERT_EQ(1 + 4 + 14 + 14 + 12, s.all_prod().sum);
+}
+
+TEST(SegtreeBeatsTest, Naive) {
+    for (int n = 1; n <= 30; n++) {
+        for (int ph = 0; ph < 10; ph++) {
+            std::vector<li> a(n);
+            for (int i = 0; i < n; i++) a[i] = randint(-20, 20);
+            seg s(amylase::beats_nodes(a));
+            for (int q = 0; q < 1000; q++) {
+                int ty = randint(0, 4);
+                int l, r;
+                std::tie(l, r) = randpair(0, n);
+                li x = randint(-20, 20);
+                if (ty == 0) {
+                    node res = s.prod(l, r);
+                    li sum = 0;
+                    for (int i = l; i < r; i++) sum += a[i];
+                    ASSERT_EQ(sum, res.sum);
+                    ASSERT_EQ(*std::max_element(a.begin() + l, a.begin() + r), res.max1);
+                    ASSERT_EQ(*std::min_element(a.begin() + l, a.begin() + r), res.min1);
+                } else if (ty == 1) {
+                    s.apply(l, r, action::chmin(x));
+                    for (int i = l; i < r; i++) a[i] = std::min(a[i], x);
+                } else if (ty == 2) {
+                    s.apply(l, r, action::chmax(x));
+                    for (int i = l; i < r; i++) a[i] = std::max(a[i], x);
+                } else if (ty == 3) {
+                    s.apply(l, r, action::plus(x));
+                    for (int i = l; i < r; i++) a[i] += x;
+                } else {
+                    s.set(l, node(x));
+                    a[l] = x;
+                }
+            }
+        }
+    }
+}
+
+TEST(SegtreeBeatsTest, Stress) {
+    // worst-ish case for the amortized analysis: many distinct values
+    // repeatedly squeezed by chmin / chmax and spread again by add.
+    const int n = 1 << 16;
+    std::vector<li> a(n);
+    for (int i = 0; i < n; i++) a[i] = li(i) * 1'000'000'007LL % n;
+    seg s(amylase::beats_nodes(a));
+    li expected = 0;
+    for (int i = 0; i < n; i++) expected += a[i];
+    for (int q = 0; q < 1000; q++) {
+        int l = randint(0, n / 4), r = randint(3 * n / 4, n);
+        li x = randint(0, n);
+        switch (q % 3) {
+            case 0: s.apply(l, r, action::chmin(x)); break;
+            case 1: s.apply(l, r, action::chmax(x)); break;
+            default: s.apply(0, n, action::plus(x % 3 - 1)); break;
+        }
+        switch (q % 3) {
+            case 0: for (int i = l; i < r; i++) a[i] = std::min(a[i], x); break;
+            case 1: for (int i = l; i < r; i++) a[i] = std::max(a[i], x); break;
+            default: for (int i = 0; i < n; i++) a[i] += x % 3 - 1; break;
+        }
+    }
+    expected = 0;
+    for (int i = 0; i < n; i++) expected += a[i];
+    ASSERT_EQ(expected, s.all_prod().sum);
+    for (int i = 0; i < n; i += 997) ASSERT_EQ(a[i], s.get(i).sum);
+}
@@ -0,0 +1,108 @@
+#include <amylase/segtrees>
+#include <atcoder/modint>
+#include "../utils/random.hpp"
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using li = long long;
+using mint = atcoder::modint998244353;
+
+TEST(SegtreesTest, SumAssign) {
+    for (int n = 1; n <= 30; n++) {
+        std::vector<li> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        amylase::sum_assign_segtree<li> s(amylase::sum_nodes(a));
+        amylase::sum_assign_segtree<li, true> t(amylase::sum_nodes(a));
+        for (int q = 0; q < 1000; q++) {
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            if (randbool()) {
+                li x = randint(-100, 100);
+                s.apply(l, r, amylase::assign_action<li>::of(x));
+                t.apply(l, r, amylase::assign_action<li>::of(x));
+                std::fill(a.begin() + l, a.begin() + r, x);
+            } else {
+                li sum = 0;
+                for (int i = l; i < r; i++) sum += a[i];
+                ASSERT_EQ(sum, s.prod(l, r).sum);
+                ASSERT_EQ(r - l, s.prod(l, r).size);
+                ASSERT_EQ(sum, t.prod(l, r).sum);
+            }
+        }
+    }
+}
+
+TEST(SegtreesTest, MinAssign) {
+    for (int n = 1; n <= 30; n++) {
+        std::vector<int> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        amylase::min_assign_segtree<int> s(a);
+        amylase::max_assign_segtree<int> t(a);
+        for (int q = 0; q < 1000; q++) {
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            if (randbool()) {
+                int x = randint(-100, 100);
+                s.apply(l, r, amylase::assign_action<int>::of(x));
+                t.apply(l, r, amylase::assign_action<int>::of(x));
+                std::fill(a.begin() + l, a.begin() + r, x);
+            } else {
+                ASSERT_EQ(*std::min_element(a.begin() + l, a.begin() + r), s.prod(l, r));
+                ASSERT_EQ(*std::max_element(a.begin() + l, a.begin() + r), t.prod(l, r));
+            }
+        }
+    }
+}
+
+TEST(SegtreesTest, SumAffine) {
+    for (int n = 1; n <= 30; n++) {
+        std::vector<mint> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(0, 1'000'000'000);
+        amylase::sum_affine_segtree<mint> s(amylase::sum_nodes(a));
+        for (int q = 0; q < 1000; q++) {
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            if (randbool()) {
+                mint b = randint(0, 1'000'000'000), c = randint(0, 1'000'000'000);
+                s.apply(l, r, amylase::affine_action<mint>{b, c});
+                for (int i = l; i < r; i++) a[i] = b * a[i] + c;
+            } else {
+                mint sum = 0;
+                for (int i = l; i < r; i++) sum += a[i];
+                ASSERT_EQ(sum.val(), s.prod(l, r).sum.val());
+            }
+        }
+    }
+}
+
+TEST(SegtreesTest, MonotoneSumMax) {
+    for (int n = 1; n <= 30; n++) {
+        std::vector<li> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        std::sort(a.begin(), a.end());
+        amylase::monotone_sum_max_segtree<li> s(a);
+        amylase::monotone_sum_min_segtree<li> t(a);
+        std::vector<li> b = a;
+        for (int q = 0; q < 1000; q++) {
+            int l, r;
+            std::tie(l, r) = randpair(0, n);
+            if (randbool()) {
+                // chmax on a suffix and chmin on a prefix keep the arrays sorted
+                li x = randint(-100, 100);
+                s.apply(l, n, x);
+                t.apply(0, r, x);
+                for (int i = l; i < n; i++) a[i] = std::max(a[i], x);
+                for (int i = 0; i < r; i++) b[i] = std::min(b[i], x);
+            } else {
+                li sa = 0, sb = 0;
+                for (int i = l; i < r; i++) sa += a[i], sb += b[i];
+                ASSERT_EQ(sa, s.prod(l, r));
+                ASSERT_EQ(sb, t.prod(l, r));
+                ASSERT_EQ(a[l], s.get(l));
+                ASSERT_EQ(b[l], t.get(l));
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include <amylase/segtrees>
+#include <amylase/sparse_table>
+#include "../utils/random.hpp"
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+std::string op(std::string a, std::string b) { return a + b; }
+std::string e() { return ""; }
+
+using disjoint_table = amylase::disjoint_sparse_table<std::string, op, e>;
+using block_table = amylase::block_sparse_table<int, amylase::min<int>, std::numeric_limits<int>::max>;
+using block_max_table = amylase::block_sparse_table<int, amylase::max<int>, std::numeric_limits<int>::lowest>;
+
+TEST(SparseTableTest, Empty) {
+    amylase::min_sparse_table<int> s;
+    ASSERT_EQ(std::numeric_limits<int>::max(), s.prod(0, 0));
+    disjoint_table t;
+    ASSERT_EQ("", t.prod(0, 0));
+    block_table u;
+    ASSERT_EQ(std::numeric_limits<int>::max(), u.prod(0, 0));
+}
+
+TEST(SparseTableTest, Naive) {
+    for (int n = 1; n <= 100; n++) {
+        std::vector<int> a(n);
+        for (int i = 0; i < n; i++) a[i] = randint(-100, 100);
+        amylase::min_sparse_table<int> s(a);
+        amylase::max_sparse_table<int> t(a);
+        amylase::sum_sparse_table<int> u(a);
+        block_table b(a);
+        block_max_table bm(a);
+        for (int l = 0; l <= n; l++) {
+            for (int r = l; r <= n; r++) {
+                int mn = std::numeric_limits<int>::max(), mx = std::numeric_limits<int>::lowest(), sum = 0;
+                for (int i = l; i < r; i++) {
+                    mn = std::min(mn, a[i]);
+                    mx = std::max(mx, a[i]);
+                    sum += a[i];
+                }
+                ASSERT_EQ(mn, s.prod(l, r));
+                ASSERT_EQ(mx, t.prod(l, r));
+                ASSERT_EQ(sum, u.prod(l, r));
+                ASSERT_EQ(mn, b.prod(l, r));
+                ASSERT_EQ(mx, bm.prod(l, r));
+            }
+        }
+        for (int i = 0; i < n; i++) {
+            ASSERT_EQ(a[i], s.get(i));
+            ASSERT_EQ(a[i], b.get(i));
+        }
+    }
+}
+
+TEST(SparseTableTest, NonCommutative) {
+    for (int n = 1; n <= 70; n++) {
+        std::vector<std::string> a(n);
+        for (int i = 0; i < n; i++) a[i] = std::to_string(i) + ",";
+        disjoint_table s(a);
+        for (int l = 0; l <= n; l++) {
+            std::string expected;
+            ASSERT_EQ(expected, s.prod(l, l));
+            for (int r = l + 1; r <= n; r++) {
+                expected += a[r - 1];
+                ASSERT_EQ(expected, s.prod(l, r));
+            }
+        }
+    }
+}
+
+TEST(SparseTableTest, BlockLarge) {
+    const int n = 1'000'000;
+    std::vector<int> a(n);
+    // few distinct values, so that there are many ties
+    for (int i = 0; i < n; i++) a[i] = i % 3 == 0 ? randint(0, 1'000'000'000) : randint(0, 10);
+    block_table b(a);
+    amylase::min_sparse_table<int> s(a);
+    for (int q = 0; q < 100'000; q++) {
+        int l, r;
+        std::tie(l, r) = randpair(0, n);
+        ASSERT_EQ(s.prod(l, r), b.prod(l, r));
+    }
+}
@@ -82,3 +82,143 @@ TEST(TwosatTest, StressOK) {
         }
     }
 }
+
+TEST(TwosatTest, AtMostOne) {
+    for (int phase = 0; phase < 3000; phase++) {
+        int n = randint(1, 10);
+        two_sat ts(n);
+        std::vector<std::vector<std::pair<int, bool>>> groups(randint(0, 3));
+        for (auto& literals : groups) {
+            literals.resize(randint(0, 8));
+            for (auto& l : literals) l = {randint(0, n - 1), randbool()};
+            ts.at_most_one(literals);
+        }
+        std::vector<int> xs(randint(0, 5)), ys(xs.size());
+        std::vector<bool> fs(xs.size()), gs(xs.size());
+        for (int i = 0; i < int(xs.size()); i++) {
+            xs[i] = randint(0, n - 1), ys[i] = randint(0, n - 1);
+            fs[i] = randbool(), gs[i] = randbool();
+            ts.add_clause(xs[i], fs[i], ys[i], gs[i]);
+        }
+        auto check = [&](const std::vector<bool>& x) {
+            for (auto& literals : groups) {
+                int count = 0;
+                for (auto l : literals) count += x[l.first] == l.second;
+                if (count > 1) return false;
+            }
+            for (int i = 0; i < int(xs.size()); i++) {
+                if (x[xs[i]] != fs[i] && x[ys[i]] != gs[i]) return false;
+            }
+            return true;
+        };
+        bool expect = false;
+        for (int s = 0; s < (1 << n); s++) {
+            std::vector<bool> x(n);
+            for (int i = 0; i < n; i++) x[i] = (s >> i) & 1;
+            if (check(x)) {
+                expect = true;
+                break;
+            }
+        }
+        ASSERT_EQ(expect, ts.satisfiable());
+        if (expect) {
+            auto actual = ts.answer();
+            ASSERT_EQ(ts.num_variables(), int(actual.size()));
+            ASSERT_TRUE(check(actual));
+        }
+    }
+}
+
+TEST(TwosatTest, AtMostOneLarge) {
+    int k = 100000;
+    two_sat ts(k);
+    ts.reserve(3 * k);
+    std::vector<std::pair<int, bool>> literals(k);
+    for (int i = 0; i < k; i++) literals[i] = {i, true};
+    ts.at_most_one(literals);
+    ASSERT_EQ(2 * k - 1, ts.num_variables());
+    ts.add_clause(k / 2, true, k / 2, true);
+    ASSERT_TRUE(ts.satisfiable());
+    auto actual = ts.answer();
+    for (int i = 0; i < k; i++) ASSERT_EQ(i == k / 2, actual[i]);
+    ts.add_clause(k - 1, true, 0, true);
+    ASSERT_FALSE(ts.satisfiable());
+}
+
+// many groups of 5 literals: each call adds O(1) clauses in amortized O(1) time
+TEST(TwosatTest, AtMostOneManyGroups) {
+    int groups = 50000;
+    two_sat ts(5 * groups);
+    for (int g = 0; g < groups; g++) {
+        std::vector<std::pair<int, bool>> literals(5);
+        for (int j = 0; j < 5; j++) literals[j] = {5 * g + j, true};
+        ts.at_most_one(literals);
+        int i = 5 * g + g % 5;
+        ts.add_clause(i, true, i, true);
+    }
+    ASSERT_TRUE(ts.satisfiable());
+    auto actual = ts.answer();
+    for (int i = 0; i < 5 * groups; i++) ASSERT_EQ(i % 5 == i / 5 % 5, actual[i]);
+    ts.add_clause(1, true, 1, true);
+    ASSERT_FALSE(ts.satisfiable());
+}
+
+TEST(TwosatTest, Assumptions) {
+    for (int phase = 0; phase < 300; phase++) {
+        int n = randint(1, 10);
+        two_sat ts(n);
+        std::vector<int> xs, ys;
+        std::vector<bool> fs, gs;
+        auto check = [&](const std::vector<bool>& x, const std::vector<std::pair<int, bool>>& assumptions) {
+            for (auto l : assumptions) {
+                if (x[l.first] != l.second) return false;
+            }
+            for (int i = 0; i < int(xs.size()); i++) {
+                if (x[xs[i]] != fs[i] && x[ys[i]] != gs[i]) return false;
+            }
+            return true;
+        };
+        // clauses are added between the queries, which invalidates the kept state
+        for (int step = 0; step < 3; step++) {
+            for (int c = randint(0, n); c > 0; c--) {
+                xs.push_back(randint(0, n - 1)), ys.push_back(randint(0, n - 1));
+                fs.push_back(randbool()), gs.push_back(randbool());
+                ts.add_clause(xs.back(), fs.back(), ys.back(), gs.back());
+            }
+            for (int q = 0; q < 10; q++) {
+                std::vector<std::pair<int, bool>> assumptions(randint(0, 3));
+                for (auto& l : assumptions) l = {randint(0, n - 1), randbool()};
+                bool expect = false;
+                for (int s = 0; s < (1 << n) && !expect; s++) {
+                    std::vector<bool> x(n);
+                    for (int i = 0; i < n; i++) x[i] = (s >> i) & 1;
+                    expect = check(x, assumptions);
+                }
+                ASSERT_EQ(expect, ts.satisfiable(assumptions));
+                if (expect) {
+                    ASSERT_TRUE(check(ts.answer(), assumptions));
+                }
+                if (randint(0, 3) == 0) {
+                    ASSERT_EQ(ts.satisfiable({}), ts.satisfiable());
+                }
+            }
+        }
+    }
+}
+
+TEST(TwosatTest, AssumptionsLarge) {
+    // x_i -> x_{i + 1} in each block of 10 variables
+    int n = 1000000;
+    two_sat ts(n);
+    for (int i = 0; i + 1 < n; i++) {
+        if ((i + 1) % 10 != 0) ts.add_clause(i, false, i + 1, true);
+    }
+    ASSERT_TRUE(ts.satisfiable({{9, false}}));
+    for (int i = 0; i < 10; i++) ASSERT_FALSE(ts.answer()[i]);
+    ASSERT_TRUE(ts.satisfiable({{0, true}}));
+    for (int i = 0; i < 10; i++) ASSERT_TRUE(ts.answer()[i]);
+    for (int q = 0; q < 100000; q++) {
+        int a = randint(0, n - 1), b = randint(0, n - 1);
+        ASSERT_EQ(a / 10 != b / 10 || b < a, ts.satisfiable({{a, true}, {b, false}}));
+    }
+}
\ No newline at end of file
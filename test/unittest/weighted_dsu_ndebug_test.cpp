@@ -0,0 +1,18 @@
+// the same results with the asserts compiled out
+#define NDEBUG
+#include <amylase/weighted_dsu>
+
+#include <gtest/gtest.h>
+
+using ll = long long;
+
+TEST(WeightedDSUNDebugTest, Diff) {
+    amylase::potential_dsu<ll> uf(4);
+    ASSERT_TRUE(uf.merge(0, 1, 5));
+    ASSERT_TRUE(uf.merge(2, 3, 7));
+    ASSERT_TRUE(uf.merge(1, 3, 1));
+    ASSERT_EQ(6, uf.diff(0, 3));
+    ASSERT_EQ(-7, uf.diff(3, 2));
+    ASSERT_EQ(6, uf.diff(2, 1));
+    ASSERT_EQ(1, uf.diff(2, 0));
+}
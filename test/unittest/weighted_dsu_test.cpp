@@ -0,0 +1,120 @@
+#include <amylase/weighted_dsu>
+#include <atcoder/modint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../utils/random.hpp"
+
+using ll = long long;
+
+namespace {
+
+// potentials relative to the smallest vertex of each component, by BFS over the accepted constraints
+struct naive {
+    int n;
+    std::vector<std::vector<std::pair<int, ll>>> g;
+    std::vector<int> comp;
+    std::vector<ll> pot;
+
+    naive(int _n) : n(_n), g(_n), comp(_n), pot(_n) { build(); }
+
+    void build() {
+        std::fill(comp.begin(), comp.end(), -1);
+        for (int s = 0; s < n; s++) {
+            if (comp[s] != -1) continue;
+            comp[s] = s;
+            pot[s] = 0;
+            std::vector<int> st = {s};
+            while (!st.empty()) {
+                int v = st.back();
+                st.pop_back();
+                for (auto e : g[v]) {
+                    if (comp[e.first] != -1) continue;
+                    comp[e.first] = s;
+                    pot[e.first] = pot[v] + e.second;
+                    st.push_back(e.first);
+                }
+            }
+        }
+    }
+
+    bool merge(int a, int b, ll w) {
+        if (comp[a] == comp[b]) return pot[b] - pot[a] == w;
+        g[a].push_back({b, w});
+        g[b].push_back({a, -w});
+        build();
+        return true;
+    }
+};
+
+}  // namespace
+
+TEST(WeightedDSUTest, Simple) {
+    amylase::potential_dsu<ll> uf(4);
+    ASSERT_TRUE(uf.merge(0, 1, 5));
+    ASSERT_TRUE(uf.merge(2, 1, -3));
+    ASSERT_EQ(5, uf.diff(0, 1));
+    ASSERT_EQ(8, uf.diff(0, 2));
+    ASSERT_EQ(-8, uf.diff(2, 0));
+    ASSERT_TRUE(uf.merge(2, 0, -8));
+    ASSERT_FALSE(uf.merge(2, 0, 8));
+    ASSERT_EQ(3, uf.size(1));
+    ASSERT_FALSE(uf.same(0, 3));
+    ASSERT_EQ(0, uf.potential(3));
+}
+
+TEST(WeightedDSUTest, Naive) {
+    for (int n = 1; n <= 20; n++) {
+        amylase::potential_dsu<ll> uf(n);
+        naive expected(n);
+        std::vector<ll> hidden(n);
+        for (auto& x : hidden) x = randint(-100, 100);
+        for (int ph = 0; ph < 100; ph++) {
+            int a = randint(0, n - 1), b = randint(0, n - 1);
+            // mostly consistent constraints, so that the groups grow
+            ll w = hidden[b] - hidden[a] + (randint(0, 4) == 0 ? randint(-2, 2) : 0);
+            ASSERT_EQ(expected.merge(a, b, w), uf.merge(a, b, w));
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    bool same = expected.comp[i] == expected.comp[j];
+                    ASSERT_EQ(same, uf.same(i, j));
+                    if (same) {
+                        ASSERT_EQ(expected.pot[j] - expected.pot[i], uf.diff(i, j));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(WeightedDSUTest, Modint) {
+    using mint = atcoder::modint998244353;
+    amylase::potential_dsu<mint> uf(3);
+    ASSERT_TRUE(uf.merge(0, 1, 998244352));
+    ASSERT_TRUE(uf.merge(1, 2, 3));
+    ASSERT_EQ(mint(2), uf.diff(0, 2));
+    ASSERT_EQ(mint(-2), uf.diff(2, 0));
+    ASSERT_FALSE(uf.merge(0, 2, 3));
+}
+
+TEST(WeightedDSUTest, Xor) {
+    // parity constraints: x_a xor x_b = w
+    amylase::xor_dsu<int> uf(4);
+    ASSERT_TRUE(uf.merge(0, 1, 1));
+    ASSERT_TRUE(uf.merge(1, 2, 1));
+    ASSERT_EQ(0, uf.diff(0, 2));
+    ASSERT_FALSE(uf.merge(2, 0, 1));
+    ASSERT_TRUE(uf.merge(3, 2, 6));
+    ASSERT_EQ(7, uf.diff(1, 3));
+}
+
+TEST(WeightedDSUTest, Line) {
+    // a long chain is compressed without recursion
+    int n = 500000;
+    amylase::potential_dsu<ll> uf(n);
+    for (int i = n - 2; i >= 0; i--) ASSERT_TRUE(uf.merge(i + 1, i, 1));
+    ASSERT_EQ(n - 1, uf.diff(n - 1, 0));
+    ASSERT_EQ(n, uf.size(n / 2));
+    for (int i = 0; i < n; i += 1000) ASSERT_EQ(ll(i), uf.diff(n - 1, n - 1 - i));
+}